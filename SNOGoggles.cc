@@ -80,6 +80,7 @@ int main( int argc, char *argv[] )
     {
       Semaphore sema;
       loadData = new ReceiverThread( options.fArgument, sema );
+      loadData->Start();
       // Wait for first event to be loaded
       sema.Wait();
     }
@@ -87,14 +88,18 @@ int main( int argc, char *argv[] )
     {
       Semaphore sema;
       if( options.fArgument.substr( options.fArgument.size() - 4 ) == string( "root" ) )
-        loadData = new LoadRootFileThread( options.fArgument, sema );
+        {
+          loadData = new LoadRootFileThread( options.fArgument, sema );
+          loadData->Start();
+        }
       else
         {
-          loadData = new LoadZdabFileThread( options.fArgument, sema );
 #ifndef __ZDAB
           cout << "Cannot load ZDAB files, scons zdab=1 will solve this - unless on a Mac." << endl;
           exit(1);
 #endif
+          loadData = new LoadZdabFileThread( options.fArgument, sema );
+          loadData->Start();
         }
       // Wait for first event to be loaded
       sema.Wait();
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////
+/// \file SNOGogglesBenchmark
+///
+/// \brief   Entry point to the headless SNOGoggles benchmarks
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Runs the viewer's data and frame code paths on synthetic
+///          events, without a window or a data file. A GenerateEventThread
+///          fills the DataStore (via the InputBuffer) whilst the main
+///          thread, as the ViewerWindow would, updates the DataStore,
+///          moves the DataSelector through the new events (running the
+///          scripts) and has a FrameManager process the latest. Then the
+///          projection rasterisation (10k hits) and the HitBuffer building
+///          are timed in isolation. Reports the throughput and the
+///          Profiler's duration percentiles per stage. An offscreen GL
+///          context stands in for the window.
+///
+////////////////////////////////////////////////////////////////////////
+#include <Python.h>
+
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <getopt.h>
+using namespace std;
+
+#include <Viewer/EventGenerator.hh>
+#include <Viewer/GenerateEventThread.hh>
+#include <Viewer/Semaphore.hh>
+#include <Viewer/DataStore.hh>
+#include <Viewer/DataSelector.hh>
+#include <Viewer/RenderState.hh>
+#include <Viewer/GeodesicSphere.hh>
+#include <Viewer/GUIProperties.hh>
+#include <Viewer/TextureManager.hh>
+#include <Viewer/Rect.hh>
+#include <Viewer/RectPtr.hh>
+#include <Viewer/FrameManager.hh>
+#include <Viewer/ProjectionRaster.hh>
+#include <Viewer/HitBuffer.hh>
+#include <Viewer/Scheduler.hh>
+#include <Viewer/Profiler.hh>
+using namespace Viewer;
+#include <Viewer/RIDS/Event.hh>
+#include <Viewer/RIDS/Channel.hh>
+
+#include <xercesc/util/PlatformUtils.hpp>
+using namespace xercesc;
+
+const int kWindowWidth = 1920; // Nominal window size, sets the frame sizes
+const int kWindowHeight = 1080;
+const int kRasterWidth = 1024; // Rasterised projection size in pixels
+const int kRasterHeight = 512;
+const int kRasterHits = 10000; // Squares per rasterisation
+
+class CmdOptions
+{
+public:
+  CmdOptions() : fEvents( 2000 ), fIterations( 500 ), fScripts( true ) { }
+
+  EventGenerator::Settings fSettings; /// < The event generation settings
+  int fEvents; /// < Number of events to generate
+  int fIterations; /// < Iterations of the isolated benchmarks
+  bool fScripts; /// < Run the selection and analysis scripts
+  std::vector<std::string> fFrames; /// < Frames to process the events with
+  std::string fTraceFile; /// < Chrome trace file to write, none if empty
+};
+/// Parse the command options
+CmdOptions ParseArguments( int argc, char *argv[] );
+/// Print the help information to the terminal
+void PrintHelp();
+
+/// Print the Profiler stats of the records since start
+void PrintStats( const std::string& title, double start );
+/// Return the render state the frames and HitBuffer use
+RenderState BenchmarkRenderState( const CmdOptions& options );
+/// Time the data and frame pipeline
+void RunPipeline( const CmdOptions& options );
+/// Time the projection rasterisation in isolation
+void RunRaster( const CmdOptions& options );
+/// Time the HitBuffer building in isolation, with the currently selected event
+void RunHitBuffer( const CmdOptions& options );
+
+int main( int argc, char *argv[] )
+{
+  CmdOptions options = ParseArguments( argc, argv );
+  Py_InitializeEx(0);
+  XMLPlatformUtils::Initialize();
+  {
+    sf::Context context; // Offscreen GL context, must outlive every GL object
+    Rect::SetWindowSize( kWindowWidth, kWindowHeight );
+    Rect::SetWindowResolution( kWindowWidth, kWindowHeight );
+    GUIProperties::GetInstance().PreInitialise( NULL );
+    GUIProperties::GetInstance().TextureInitialise();
+    Profiler::GetInstance(); // Start timing the Scheduler tasks
+    DataStore::GetInstance();
+    DataSelector::GetInstance();
+
+    RunPipeline( options );
+    RunRaster( options );
+    RunHitBuffer( options );
+
+    if( !options.fTraceFile.empty() && Profiler::GetInstance().WriteChromeTrace( options.fTraceFile ) )
+      cout << "Profile saved to " << options.fTraceFile << endl;
+    TextureManager::GetInstance().ClearTextures();
+  }
+  Py_Finalize();
+  GUIProperties::GetInstance().Destruct();
+  XMLPlatformUtils::Terminate();
+  return 0;
+}
+
+RenderState
+BenchmarkRenderState( const CmdOptions& options )
+{
+  // The last generated source, a charge type if there is one
+  RenderState renderState( options.fSettings.fSources - 1, options.fSettings.fTypes > 1 ? 1 : 0 );
+  renderState.ChangeScaling( 0.0, 4096.0 );
+  return renderState;
+}
+
+void
+RunPipeline( const CmdOptions& options )
+{
+  EventGenerator generator( options.fSettings );
+  generator.InitialiseRIDS();
+  Semaphore sema;
+  GenerateEventThread generateThread( generator, options.fEvents, sema );
+  generateThread.Start();
+  // Wait for first event to be loaded
+  sema.Wait();
+  GeodesicSphere::GetInstance();
+  DataStore::GetInstance().Initialise();
+  DataSelector::GetInstance().Initialise();
+  DataSelector::GetInstance().SetSelect( options.fScripts );
+  DataSelector::GetInstance().SetAnalyse( options.fScripts );
+
+  Rect& motherRect = Rect::NewMother();
+  FrameManager* frameManager = new FrameManager( RectPtr( motherRect.NewDaughter() ) );
+  frameManager->PreInitialise( NULL );
+  frameManager->PostInitialise( NULL );
+  for( vector<string>::const_iterator iTer = options.fFrames.begin(); iTer != options.fFrames.end(); iTer++ )
+    frameManager->NewFrame( *iTer );
+  RenderState renderState = BenchmarkRenderState( options );
+
+  // As the ViewerWindow, but Move through every new event so that the scripts see each one, the
+  // frames process only the latest of each batch. Update adds at most the buffer size, so no event
+  // is overwritten before it is selected
+  Profiler& profiler = Profiler::GetInstance();
+  const double start = profiler.Now();
+  int eventsSelected = 1; // The DataSelector initialises on the first event
+  int frames = 0;
+  bool force = true;
+  while( eventsSelected < options.fEvents )
+    {
+      const double updateStart = profiler.Now();
+      DataStore::GetInstance().Update();
+      const int newEvents = DataStore::GetInstance().GetEventsAdded() - eventsSelected;
+      if( newEvents == 0 && !force )
+        {
+          sf::sleep( sf::milliseconds( 1 ) ); // Waiting for the generator, not worth recording
+          continue;
+        }
+      profiler.Record( "DataStore::Update", updateStart, profiler.Now() );
+      Profiler::Scope frameScope( "Frame" );
+      {
+        Profiler::Scope moveScope( "DataSelector::Move" );
+        DataSelector::GetInstance().Move( newEvents );
+      }
+      eventsSelected += newEvents;
+      if( force || DataSelector::GetInstance().RunChanged() )
+        frameManager->ProcessRun();
+      frameManager->ProcessEvent( renderState );
+      frameManager->Reset();
+      renderState.Reset();
+      DataSelector::GetInstance().Reset();
+      force = false;
+      frames++;
+    }
+  const double elapsed = profiler.Now() - start;
+  generateThread.KillAndWait();
+  delete frameManager;
+
+  cout << fixed << setprecision( 1 );
+  cout << "Pipeline: " << eventsSelected << " events, " << frames << " frames in " << elapsed << "s, "
+       << eventsSelected / elapsed << " events/s, " << frames / elapsed << " frames/s" << endl;
+  PrintStats( "Pipeline", start );
+}
+
+void
+RunRaster( const CmdOptions& options )
+{
+  ProjectionRaster raster;
+  const vector<sf::Uint32> background( kRasterWidth * kRasterHeight, 0xff202020 );
+  raster.SetBackground( &background[0], kRasterWidth, kRasterHeight, sf::Vector2<int>( 2, 2 ) );
+  srand( options.fSettings.fSeed );
+  vector<ProjectionRaster::Square> hits( kRasterHits );
+  for( size_t iHit = 0; iHit < hits.size(); iHit++ )
+    {
+      hits[iHit].fX = rand() % kRasterWidth;
+      hits[iHit].fY = rand() % kRasterHeight;
+      hits[iHit].fColour = 0xff000000 | rand();
+    }
+  ProjectionRaster::Product product;
+  vector<ProjectionRaster::Square> squares;
+  const double start = Profiler::GetInstance().Now();
+  for( int iIteration = 0; iIteration < options.fIterations; iIteration++ )
+    {
+      Profiler::Scope scope( "Raster 10k hits" );
+      squares = hits;
+      raster.Submit( squares );
+      Scheduler::GetInstance().Wait( raster );
+      raster.Acquire( product );
+    }
+  const double elapsed = Profiler::GetInstance().Now() - start;
+  cout << "Raster: " << options.fIterations / elapsed << " rasterisations/s, "
+       << options.fIterations * kRasterHits / elapsed / 1.0e6 << " Mhits/s" << endl;
+  PrintStats( "Raster", start );
+}
+
+void
+RunHitBuffer( const CmdOptions& options )
+{
+  const RenderState renderState = BenchmarkRenderState( options );
+  const vector<RIDS::Channel>& hits = DataSelector::GetInstance().GetData( renderState.GetDataSource(), renderState.GetDataType() );
+  HitBuffer hitBuffer;
+  hitBuffer.SetPositions( DataSelector::GetInstance().GetChannelList() );
+  const double start = Profiler::GetInstance().Now();
+  for( int iIteration = 0; iIteration < options.fIterations; iIteration++ )
+    {
+      Profiler::Scope scope( "HitBuffer build" );
+      hitBuffer.ClearHits();
+      for( vector<RIDS::Channel>::const_iterator iTer = hits.begin(); iTer != hits.end(); iTer++ )
+        hitBuffer.AddHit( iTer->GetID(), iTer->GetData(), renderState );
+      hitBuffer.BindHits();
+    }
+  const double elapsed = Profiler::GetInstance().Now() - start;
+  cout << "HitBuffer: " << hits.size() << " hits, " << options.fIterations / elapsed << " builds/s" << endl;
+  PrintStats( "HitBuffer", start );
+}
+
+void
+PrintStats( const string& title,
+            double start )
+{
+  vector<Profiler::Stat> stats;
+  Profiler::GetInstance().GetStats( Profiler::GetInstance().Now() - start, stats );
+  cout << title << " stages, ms:" << endl;
+  cout << setw( 40 ) << left << "stage" << right << setw( 8 ) << "count" << setw( 10 ) << "total"
+       << setw( 10 ) << "median" << setw( 10 ) << "p95" << setw( 10 ) << "max" << endl;
+  cout << fixed << setprecision( 3 );
+  for( vector<Profiler::Stat>::const_iterator iTer = stats.begin(); iTer != stats.end(); iTer++ )
+    cout << setw( 40 ) << left << iTer->fName << right << setw( 8 ) << iTer->fCount << setw( 10 ) << iTer->fTotal * 1.0e3
+         << setw( 10 ) << iTer->fMedian * 1.0e3 << setw( 10 ) << iTer->fP95 * 1.0e3 << setw( 10 ) << iTer->fMax * 1.0e3 << endl;
+  cout << endl;
+}
+
+CmdOptions
+ParseArguments( int argc, char** argv )
+{
+  static struct option opts[] = { {"help", 0, NULL, 'h'}, {"events", 1, NULL, 'n'}, {"rate", 1, NULL, 'r'},
+                                  {"nhit", 1, NULL, 'm'}, {"distribution", 1, NULL, 'd'}, {"sources", 1, NULL, 's'},
+                                  {"types", 1, NULL, 'y'}, {"tracks", 1, NULL, 'k'}, {"frames", 1, NULL, 'f'},
+                                  {"iterations", 1, NULL, 'i'}, {"no-scripts", 0, NULL, 'x'}, {"trace", 1, NULL, 't'},
+                                  {0,0,0,0} };
+  const char* shortOpts = "hn:r:m:d:s:y:k:f:i:xt:";
+  CmdOptions options;
+  options.fSettings.fRate = 0.0; // As fast as possible, unless asked
+  string frames = "Histogram,Lambert,Icosahedral,Crate View,Hits,Tracks";
+  int option_index = 0;
+  int c = getopt_long(argc, argv, shortOpts, opts, &option_index);
+  while (c != -1)
+    {
+      switch (c)
+        {
+        case 'h': PrintHelp(); exit(0); break;
+        case 'n': options.fEvents = atoi( optarg ); break;
+        case 'r': options.fSettings.fRate = atof( optarg ); break;
+        case 'm': options.fSettings.fMeanNhit = atof( optarg ); break;
+        case 'd':
+          {
+            const string distribution( optarg );
+            if( distribution == "fixed" )
+              options.fSettings.fDistribution = EventGenerator::eFixed;
+            else if( distribution == "uniform" )
+              options.fSettings.fDistribution = EventGenerator::eUniform;
+            else if( distribution == "poisson" )
+              options.fSettings.fDistribution = EventGenerator::ePoisson;
+            else if( distribution == "exponential" )
+              options.fSettings.fDistribution = EventGenerator::eExponential;
+            else
+              {
+                PrintHelp();
+                exit(1);
+              }
+          }
+          break;
+        case 's': options.fSettings.fSources = atoi( optarg ); break;
+        case 'y': options.fSettings.fTypes = atoi( optarg ); break;
+        case 'k': options.fSettings.fTracks = atoi( optarg ); break;
+        case 'f': frames = optarg; break;
+        case 'i': options.fIterations = atoi( optarg ); break;
+        case 'x': options.fScripts = false; break;
+        case 't': options.fTraceFile = optarg; break;
+        default: PrintHelp(); exit(1); break;
+        }
+      c = getopt_long(argc, argv, shortOpts, opts, &option_index);
+    }
+  stringstream frameStream( frames );
+  string frame;
+  while( getline( frameStream, frame, ',' ) )
+    if( !frame.empty() )
+      options.fFrames.push_back( frame );
+  options.fEvents = max( 1, options.fEvents );
+  options.fIterations = max( 1, options.fIterations );
+  return options;
+}
+
+void
+PrintHelp()
+{
+  cout << "usage:snogoggles_benchmark [options]" << endl;
+  cout << "options:" << endl;
+  cout << " -h             show this help message and exit" << endl;
+  cout << " -n events      number of events to generate, default 2000" << endl;
+  cout << " -r rate        event rate in Hz, default as fast as possible" << endl;
+  cout << " -m nhit        mean nhit, default 1000" << endl;
+  cout << " -d dist        nhit distribution: fixed, uniform, poisson (default) or exponential" << endl;
+  cout << " -s sources     number of data sources (1-4), default 4" << endl;
+  cout << " -y types       number of types per source (1-4), default 4" << endl;
+  cout << " -k tracks      tracks per event, default 0" << endl;
+  cout << " -f frames      comma separated frame names to process with" << endl;
+  cout << " -i iterations  iterations of the raster and HitBuffer benchmarks, default 500" << endl;
+  cout << " -x             do not run the selection and analysis scripts" << endl;
+  cout << " -t path        save a Chrome trace to path" << endl;
+}
@@ -0,0 +1,300 @@
+////////////////////////////////////////////////////////////////////////
+/// \file SNOGogglesGolden
+///
+/// \brief   Checks the batch projections against the scalar reference
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  The Lambert and Icosahedral projections work in batches over
+///          flat arrays. This projects random positions with them and
+///          with the original scalar, ROOT vector, maths and fails (exit
+///          code 1) if any projected coordinate differs by more than the
+///          tolerance. Run after changing either projection.
+///
+////////////////////////////////////////////////////////////////////////
+#include <TVector3.h>
+#include <TVector2.h>
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/ProjectionCache.hh>
+#include <Viewer/LambertProjection.hh>
+#include <Viewer/IcosahedralProjection.hh>
+using namespace Viewer;
+using namespace Viewer::Frames;
+
+const size_t kPositions = 100000; // Random positions checked per projection
+const double kTolerance = 1.0e-9; // Largest allowed difference in local coords
+const double kMaxCosTheta = 0.999; // Random positions nearer +z are skipped, Lambert is singular at +z
+
+namespace Reference
+{
+// The scalar projections as they were before batching, do not optimise these
+
+  const double a = 1.0 / 5.5;
+  const double b = a * sqrt( 3.0 ) / 2.0;
+
+  const TVector2 A12a = TVector2( a / 2.0, 0.0 );
+  const TVector2 A12b = TVector2( 3.0 * a / 2.0, 0.0 );
+  const TVector2 A12c = TVector2( 5.0 * a / 2.0, 0.0 );
+  const TVector2 A12d = TVector2( 7.0 *a / 2.0, 0.0 );
+  const TVector2 A12e = TVector2( 9.0 * a / 2.0, 0.0 );
+  const TVector2 A2a = TVector2( 0.0, b );
+  const TVector2 A2b = TVector2( 5.0 * a, b );
+  const TVector2 A17a = TVector2( a / 2.0 , 2.0 * b );
+  const TVector2 A17b = TVector2( 11.0 * a / 2.0 , 2.0 * b );
+  const TVector2 A51a = TVector2( a, 3.0 * b );
+  const TVector2 A51b = TVector2( 2.0 * a, 3.0 * b );
+  const TVector2 A51c = TVector2( 3.0 * a, 3.0 * b );
+  const TVector2 A51d = TVector2( 4.0 * a, 3.0 * b );
+  const TVector2 A51e = TVector2( 5.0 * a, 3.0 * b );
+  const TVector2 A27 = TVector2( 4.0 * a, b );
+  const TVector2 A46 = TVector2( 3.0 * a, b );
+  const TVector2 A31 = TVector2( 2.0 * a, b );
+  const TVector2 A6 = TVector2( a, b );
+  const TVector2 A37 = TVector2( 9.0 * a / 2.0 , 2.0 * b );
+  const TVector2 A33 = TVector2( 3.0 * a / 2.0 , 2.0 * b );
+  const TVector2 A58 = TVector2( 5.0 * a / 2.0 , 2.0 * b );
+  const TVector2 A54 = TVector2( 7.0 * a / 2.0 , 2.0 * b );
+
+sf::Vector2<double>
+Lambert( const sf::Vector3<double>& channelPos )
+{
+  TVector3 pmtPos( channelPos.x, channelPos.y, channelPos.z );
+  pmtPos = pmtPos.Unit();
+  const double x = sqrt( 2 / ( 1 - pmtPos.z() ) ) * pmtPos.x() / 4.0 + 0.5; // Projected circle radius is 2 thus diameter 4
+  const double y = sqrt( 2 / ( 1 - pmtPos.z() ) ) * pmtPos.y() / 4.0 + 0.5; // +0.5 such that x,y E [0, 1)
+  return sf::Vector2<double>( x, y );
+}
+
+TVector2
+TransformCoord( const TVector3& V1,
+                const TVector3& V2,
+                const TVector3& V3,
+                const TVector2& A1,
+                const TVector2& A2,
+                const TVector2& A3,
+                const TVector3& P )
+{
+  TVector3 xV = V2 - V1;
+  TVector3 yV = ( ( V3 - V1 ) + ( V3 - V2 ) ) * 0.5;
+  TVector3 zV = xV.Cross( yV ).Unit();
+
+  double planeD = V1.Dot( zV );
+
+  double t = planeD / P.Dot( zV );
+
+  TVector3 localP = t*P - V1;
+
+  TVector2 xA = A2 - A1;
+  TVector2 yA = ( ( A3 - A1 ) +( A3 - A2 ) )  * 0.5;
+
+  double convUnits = xA.Mod() / xV.Mag();
+
+  TVector2 result;
+  result = localP.Dot( xV.Unit() ) * xA.Unit() * convUnits;
+  result += localP.Dot( yV.Unit() ) * yA.Unit() * convUnits + A1;
+  return result;
+}
+
+sf::Vector2<double>
+Icosahedral( const sf::Vector3<double>& pmtPos )
+{
+  TVector3 pointOnSphere( pmtPos.x, pmtPos.y, pmtPos.z );
+  pointOnSphere = pointOnSphere.Unit();
+  pointOnSphere.RotateX( -45.0 );
+  const double t = ( 1.0 + sqrt( 5.0 ) ) / 2.0;
+
+  const TVector3 V2 = TVector3( t * t, 0.0, t * t * t ).Unit();
+  const TVector3 V6 = TVector3( -t * t, 0.0, t * t * t ).Unit();
+  const TVector3 V12 = TVector3( 0.0, t * t * t, t * t ).Unit();
+  const TVector3 V17 = TVector3( 0.0, -t * t * t, t * t ).Unit();
+  const TVector3 V27 = TVector3( t * t * t, t * t, 0.0 ).Unit();
+  const TVector3 V31 = TVector3( -t * t * t, t * t, 0.0 ).Unit();
+  const TVector3 V33 = TVector3( -t * t * t, -t * t, 0.0 ).Unit();
+  const TVector3 V37 = TVector3( t * t * t, -t * t, 0.0 ).Unit();
+  const TVector3 V46 = TVector3( 0.0, t * t * t, -t * t ).Unit();
+  const TVector3 V51 = TVector3( 0.0, -t * t * t, -t * t ).Unit();
+  const TVector3 V54 = TVector3( t * t, 0.0, -t * t * t ).Unit();
+  const TVector3 V58 = TVector3( -t * t, 0.0, -t * t * t ).Unit();
+  vector<TVector3> IcosahedralCentres;
+  IcosahedralCentres.push_back( ( V2 + V6 + V17 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V2 + V12 + V6 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V2 + V17 + V37 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V2 + V37 + V27 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V2 + V27 + V12 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V37 + V54 + V27 ) * ( 1.0 / 3.0 ) );
+
+  IcosahedralCentres.push_back( ( V27 + V54 + V46 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V27 + V46 + V12 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V12 + V46 + V31 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V12 + V31 + V6 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V6 + V31 + V33 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V6 + V33 + V17 ) * ( 1.0 / 3.0 ) );
+
+  IcosahedralCentres.push_back( ( V17 + V33 + V51 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V17 + V51 + V37 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V37 + V51 + V54 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V58 + V54 + V51 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V58 + V46 + V54 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V58 + V31 + V46 ) * ( 1.0 / 3.0 ) );
+
+  IcosahedralCentres.push_back( ( V58 + V33 + V31 ) * ( 1.0 / 3.0 ) );
+  IcosahedralCentres.push_back( ( V58 + V51 + V33 ) * ( 1.0 / 3.0 ) );
+
+  vector<double> distFromCentre;
+  unsigned int uLoop;
+  for( uLoop = 0; uLoop < IcosahedralCentres.size(); uLoop++ )
+    distFromCentre.push_back( ( IcosahedralCentres[uLoop] - pointOnSphere ).Mag() );
+  const int face = min_element( distFromCentre.begin(), distFromCentre.end() ) - distFromCentre.begin() + 1;
+
+  TVector2 resultPosition;
+  switch(face)
+    {
+    case 1://{ 2, 6, 17}
+      resultPosition = TransformCoord( V2, V6, V17, A2a, A6, A17a, pointOnSphere );
+      break;
+    case 2://{ 2, 12, 6}
+      resultPosition = TransformCoord( V2, V12, V6, A2a, A12a, A6, pointOnSphere );
+      break;
+    case 3://{ 2, 17, 37}
+      resultPosition = TransformCoord( V2, V17, V37, A2b, A17b, A37, pointOnSphere );
+      break;
+    case 4://{ 2, 37, 27}
+      resultPosition = TransformCoord( V2, V37, V27, A2b, A37, A27, pointOnSphere );
+      break;
+    case 5://{ 2, 27, 12}
+      resultPosition = TransformCoord( V2, V27, V12, A2b, A27, A12e, pointOnSphere );
+      break;
+    case 6://{37, 54, 27}
+      resultPosition = TransformCoord( V37, V54, V27, A37, A54, A27, pointOnSphere );
+      break;
+    case 7://{27, 54, 46}
+      resultPosition = TransformCoord( V27, V54, V46, A27, A54, A46, pointOnSphere );
+      break;
+    case 8://{27, 46, 12}
+      resultPosition = TransformCoord( V27, V46, V12, A27, A46, A12d, pointOnSphere );
+      break;
+    case 9://{12, 46, 31}
+      resultPosition = TransformCoord( V12, V46, V31, A12c, A46, A31, pointOnSphere );
+      break;
+    case 10://{12, 31, 6}
+      resultPosition = TransformCoord( V12, V31, V6, A12b, A31, A6, pointOnSphere );
+      break;
+    case 11://{ 6, 31, 33}
+      resultPosition = TransformCoord( V6, V31, V33, A6, A31, A33, pointOnSphere );
+      break;
+    case 12://{ 6, 33, 17}
+      resultPosition = TransformCoord( V6, V33, V17, A6, A33, A17a, pointOnSphere );
+      break;
+    case 13://{17, 33, 51}
+      resultPosition = TransformCoord( V17, V33, V51, A17a, A33, A51a, pointOnSphere );
+      break;
+    case 14://{17, 51, 37}
+      resultPosition = TransformCoord( V17, V51, V37, A17b, A51e, A37, pointOnSphere );
+      break;
+    case 15://{37, 51, 54}
+      resultPosition = TransformCoord( V37, V51, V54, A37, A51d, A54, pointOnSphere );
+      break;
+    case 16://{58, 54, 51}
+      resultPosition = TransformCoord( V58, V54, V51, A58, A54, A51c, pointOnSphere );
+      break;
+    case 17://{58, 46, 54}
+      resultPosition = TransformCoord( V58, V46, V54, A58, A46, A54, pointOnSphere );
+      break;
+    case 18://{58, 31, 46}
+      resultPosition = TransformCoord( V58, V31, V46, A58, A31, A46, pointOnSphere );
+      break;
+    case 19://{58, 33, 31}
+      resultPosition = TransformCoord( V58, V33, V31, A58, A33, A31, pointOnSphere );
+      break;
+    case 20://{58, 51, 33}
+      resultPosition = TransformCoord( V58, V51, V33, A58, A51b, A33, pointOnSphere );
+      break;
+    }
+  return sf::Vector2<double>( resultPosition.X(), 2.0 * resultPosition.Y() );
+}
+
+} // ::Reference
+
+/// Return the absolute difference, zero if both are NaN (singular in both) and NaN if only one is
+double Difference( double value,
+                   double expected );
+
+/// Project the positions with both, print the largest difference and return true if all are within tolerance
+bool Check( const string& name,
+            ProjectionCache::ProjectFunction batch,
+            sf::Vector2<double> (*scalar)( const sf::Vector3<double>& ),
+            const vector<double>& xyz );
+
+int main()
+{
+  // Random directions at random radii (mm), as interleaved xyz
+  srand( 1 );
+  vector<double> xyz;
+  while( xyz.size() < kPositions * 3 )
+    {
+      const double x = 2.0 * rand() / RAND_MAX - 1.0;
+      const double y = 2.0 * rand() / RAND_MAX - 1.0;
+      const double z = 2.0 * rand() / RAND_MAX - 1.0;
+      const double mag = sqrt( x * x + y * y + z * z );
+      if( mag < 1.0e-3 || mag > 1.0 || z / mag > kMaxCosTheta )
+        continue;
+      const double radius = 1.0 + 9999.0 * rand() / RAND_MAX;
+      xyz.push_back( x / mag * radius );
+      xyz.push_back( y / mag * radius );
+      xyz.push_back( z / mag * radius );
+    }
+  // The zero vector and the poles, where the reference may give NaN and the batch must agree
+  const double special[] = { 0.0, 0.0, 0.0,  0.0, 0.0, 6000.0,  0.0, 0.0, -6000.0 };
+  xyz.insert( xyz.end(), special, special + sizeof( special ) / sizeof( double ) );
+  const bool lambert = Check( LambertProjection::Name(), &LambertProjection::Project, &Reference::Lambert, xyz );
+  const bool icosahedral = Check( IcosahedralProjection::Name(), &IcosahedralProjection::Project, &Reference::Icosahedral, xyz );
+  return lambert && icosahedral ? 0 : 1;
+}
+
+bool
+Check( const string& name,
+       ProjectionCache::ProjectFunction batch,
+       sf::Vector2<double> (*scalar)( const sf::Vector3<double>& ),
+       const vector<double>& xyz )
+{
+  const size_t count = xyz.size() / 3;
+  vector<double> uv( count * 2 );
+  batch( &xyz[0], count, &uv[0] );
+  double maxDiff = 0.0;
+  size_t failures = 0;
+  for( size_t iPos = 0; iPos < count; iPos++ )
+    {
+      const sf::Vector2<double> expected = scalar( sf::Vector3<double>( xyz[iPos * 3], xyz[iPos * 3 + 1], xyz[iPos * 3 + 2] ) );
+      const double diff = max( Difference( uv[iPos * 2], expected.x ), Difference( uv[iPos * 2 + 1], expected.y ) );
+      if( !( diff <= kTolerance ) ) // Also fails on NaN
+        failures++;
+      else
+        maxDiff = max( maxDiff, diff );
+    }
+  cout << name << ": " << count << " positions, largest difference " << maxDiff << ", "
+       << failures << " beyond " << kTolerance << endl;
+  return failures == 0;
+}
+
+double
+Difference( double value,
+            double expected )
+{
+  if( value != value && expected != expected )
+    return 0.0;
+  return fabs( value - expected );
+}
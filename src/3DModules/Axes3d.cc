@@ -1,4 +1,7 @@
+#include <TVector3.h>
+
 #include <Viewer/Axes3d.hh>
+#include <Viewer/StaticScene.hh>
 #include <Viewer/PersistLabel.hh>
 #include <Viewer/ConfigurationTable.hh>
 #include <Viewer/GUIProperties.hh>
@@ -40,31 +43,24 @@ Axes3d::PreInitialise( const ConfigurationTable* configTable )
 }
 
 void
-Axes3d::Render3d()
+Axes3d::BuildStatic( StaticScene& scene )
 {
-  if( !fDisplay )
-    return;
-  RenderAxis( sf::Vector3<double>( kSize, 0.0, 0.0 ),
-              GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eRed ) );
-  RenderAxis( sf::Vector3<double>( 0.0, kSize, 0.0 ),
-              GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGreen ) );
-  RenderAxis( sf::Vector3<double>( 0.0, 0.0, kSize ),
-              GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eBlue ) );
+  scene.NewGroup( fDisplay );
+  AddAxis( scene, sf::Vector3<double>( kSize, 0.0, 0.0 ),
+           GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eRed ) );
+  AddAxis( scene, sf::Vector3<double>( 0.0, kSize, 0.0 ),
+           GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGreen ) );
+  AddAxis( scene, sf::Vector3<double>( 0.0, 0.0, kSize ),
+           GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eBlue ) );
 }
 
 void 
-Axes3d::RenderAxis( const sf::Vector3<double>& point, 
-                    Colour colour )
+Axes3d::AddAxis( StaticScene& scene,
+                 const sf::Vector3<double>& point, 
+                 const Colour& colour )
 {
-  glDisable( GL_DEPTH_TEST );
-  glPushAttrib( GL_COLOR );
-  colour.SetOpenGL();
-
-  glBegin( GL_LINES );
-  glVertex3f( 0, 0, 0 );
-  glVertex3f( point.x, point.y, point.z );
-  glEnd();
-
-  glPopAttrib();
-  glEnable( GL_DEPTH_TEST );
+  scene.AddIndex( StaticScene::eOverlayLines, scene.fVertices.size() );
+  scene.AddVertex( Vertex( TVector3( 0.0, 0.0, 0.0 ), colour ) );
+  scene.AddIndex( StaticScene::eOverlayLines, scene.fVertices.size() );
+  scene.AddVertex( Vertex( TVector3( point.x, point.y, point.z ), colour ) );
 }
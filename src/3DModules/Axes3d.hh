@@ -11,7 +11,8 @@
 ///
 /// \detail  Modification of the original Axes3d class to take account
 ///          of codebase changes.
-///          Draws the x, y, z axes into the viewport area
+///          Draws the x, y, z axes into the viewport area, as lines in
+///          the frame's StaticScene.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -43,15 +44,18 @@ public:
   virtual void ProcessEvent( const RenderState& renderState ) { };
   /// Process run data
   virtual void ProcessRun() { };
-  /// Render all 3d objects
-  virtual void Render3d();
+  /// Add the axes to the static scene
+  virtual void BuildStatic( StaticScene& scene );
+  /// Render all 3d objects, nothing to do here (see BuildStatic)
+  virtual void Render3d() { };
   /// Return the module name
   virtual std::string GetName() { return Axes3d::Name(); }
   static std::string Name() { return std::string( "Axes3d" ); }
 protected:
-  /// Render a single axis
-  void RenderAxis( const sf::Vector3<double>& point,
-                   Colour colour );
+  /// Add a single axis
+  void AddAxis( StaticScene& scene,
+                const sf::Vector3<double>& point,
+                const Colour& colour );
   bool fDisplay; /// < Show the axes?
 };
 
@@ -9,6 +9,7 @@
 #include <Viewer/ConfigurationTable.hh>
 #include <Viewer/Rotation.hh>
 #include <Viewer/DragArea.hh>
+#include <Viewer/FramePacer.hh>
 using namespace Viewer;
 
 const double kMaxZoom = 1.5;
@@ -96,6 +97,7 @@ Arcball3d::EventLoop()
     {
       Rotation zRotation( TVector3( 0.0, 0.0 ,1.0 ), kSpinSpeed * fClock.getElapsedTime().asSeconds() ); // Rotate about the z axis
       Rotate( zRotation );
+      FramePacer::GetInstance().Invalidate(); // Keep spinning
     }
   fClock.restart();
 }
@@ -7,6 +7,7 @@
 #include <Viewer/PersistLabel.hh>
 #include <Viewer/ConfigurationTable.hh>
 #include <Viewer/GUIEvent.hh>
+#include <Viewer/StaticScene.hh>
 using namespace Viewer;
 #include <Viewer/RIDS/FibreList.hh>
 
@@ -69,80 +70,27 @@ Fibre3d::PreInitialise( const ConfigurationTable* configTable )
 }
 
 void
-Fibre3d::ProcessRun()
+Fibre3d::BuildStatic( StaticScene& scene )
 {
   const RIDS::FibreList& fibreList = DataSelector::GetInstance().GetFibreList();
-  fAMELLIEPos.Clear();
-  fAMELLIEDir.Clear();
-  fSMELLIEPos.Clear();
-  fSMELLIEDir.Clear();
-  fTELLIEPos.Clear();
-  fTELLIEDir.Clear();
-  for( size_t iFibre = 0; iFibre < fibreList.GetFibreCount(); iFibre++ )
+  const RIDS::FibreList::EType types[3] = { RIDS::FibreList::eAMELLIE, RIDS::FibreList::eSMELLIE, RIDS::FibreList::eTELLIE };
+  const bool* displays[3] = { &fDisplayAMELLIE, &fDisplaySMELLIE, &fDisplayTELLIE };
+  for( int iType = 0; iType < 3; iType++ )
     {
-      switch( fibreList.GetType( iFibre ) )
+      scene.NewGroup( *displays[iType] );
+      const Colour colour = GUIProperties::GetInstance().GetColourPalette().GetColour( iType );
+      for( size_t iFibre = 0; iFibre < fibreList.GetFibreCount(); iFibre++ )
         {
-        case RIDS::FibreList::eAMELLIE:
-          AddPosVertices( fAMELLIEPos, 
-                          fibreList.GetPosition( iFibre ), 
-                          GUIProperties::GetInstance().GetColourPalette().GetColour( 0 ) );
-          AddDirVertices( fAMELLIEDir, 
-                          fibreList.GetPosition( iFibre ), 
-                          fibreList.GetDirection( iFibre ),
-                          GUIProperties::GetInstance().GetColourPalette().GetColour( 0 ) );
-          break;
-        case RIDS::FibreList::eSMELLIE:
-          AddPosVertices( fSMELLIEPos, 
-                          fibreList.GetPosition( iFibre ), 
-                          GUIProperties::GetInstance().GetColourPalette().GetColour( 1 ) );
-          AddDirVertices( fSMELLIEDir, 
-                          fibreList.GetPosition( iFibre ), 
-                          fibreList.GetDirection( iFibre ),
-                          GUIProperties::GetInstance().GetColourPalette().GetColour( 1 ) );
-          break;
-        case RIDS::FibreList::eTELLIE:
-          AddPosVertices( fTELLIEPos, 
-                          fibreList.GetPosition( iFibre ), 
-                          GUIProperties::GetInstance().GetColourPalette().GetColour( 2 ) );
-          AddDirVertices( fTELLIEDir, 
-                          fibreList.GetPosition( iFibre ), 
-                          fibreList.GetDirection( iFibre ),
-                          GUIProperties::GetInstance().GetColourPalette().GetColour( 2 ) );
-          break;
+          if( fibreList.GetType( iFibre ) != types[iType] )
+            continue;
+          AddPosVertices( scene, fibreList.GetPosition( iFibre ), colour );
+          AddDirVertices( scene, fibreList.GetPosition( iFibre ), fibreList.GetDirection( iFibre ), colour );
         }
     }
-  fAMELLIEPos.Bind();
-  fAMELLIEDir.Bind();
-  fSMELLIEPos.Bind();
-  fSMELLIEDir.Bind();
-  fTELLIEPos.Bind();
-  fTELLIEDir.Bind();
-}
-
-void
-Fibre3d::Render3d()
-{
-  glDisable( GL_DEPTH_TEST );
-  if( fDisplayAMELLIE )
-    {
-      fAMELLIEPos.Render( GL_TRIANGLES );
-      fAMELLIEDir.Render( GL_LINES );
-    }
-  if( fDisplaySMELLIE )
-    {
-      fSMELLIEPos.Render( GL_TRIANGLES );
-      fSMELLIEDir.Render( GL_LINES );
-    }
-  if( fDisplayTELLIE )
-    {
-      fTELLIEPos.Render( GL_TRIANGLES );
-      fTELLIEDir.Render( GL_LINES );
-    }
-  glEnable( GL_DEPTH_TEST );
 }
 
 void
-Fibre3d::AddPosVertices( VBO& vbo, 
+Fibre3d::AddPosVertices( StaticScene& scene, 
                          const sf::Vector3<double>& pos,
                          const Colour& colour )
 {
@@ -157,13 +105,13 @@ Fibre3d::AddPosVertices( VBO& vbo,
       double a = 2 * TMath::Pi() * iLoop / 3.0;
       TVector3 v = TVector3( kSize * sin(a) / 2.0, kSize * cos(a) / 2.0, p.Mag() );
       v.Rotate( angle, axis );
-      vbo.AddVertex( Vertex( v, colour ) );
-      vbo.AddIndex( vbo.fIndices.size() );
+      scene.AddIndex( StaticScene::eOverlayTriangles, scene.fVertices.size() );
+      scene.AddVertex( Vertex( v, colour ) );
     }
 }
 
 void
-Fibre3d::AddDirVertices( VBO& vbo,
+Fibre3d::AddDirVertices( StaticScene& scene,
                          const sf::Vector3<double>& pos,
                          const sf::Vector3<double>& dir,
                          const Colour& colour )
@@ -171,8 +119,8 @@ Fibre3d::AddDirVertices( VBO& vbo,
   const TVector3 p( pos.x, pos.y, pos.z );
   const TVector3 pdir( dir.x, dir.y, dir.z );
   const TVector3 p2 = p + pdir * kSize;
-  vbo.AddVertex( Vertex( p, colour ) );
-  vbo.AddVertex( Vertex( p2, colour ) );
-  vbo.AddIndex( vbo.fIndices.size() );
-  vbo.AddIndex( vbo.fIndices.size() );
+  scene.AddIndex( StaticScene::eOverlayLines, scene.fVertices.size() );
+  scene.AddVertex( Vertex( p, colour ) );
+  scene.AddIndex( StaticScene::eOverlayLines, scene.fVertices.size() );
+  scene.AddVertex( Vertex( p2, colour ) );
 }
@@ -8,7 +8,8 @@
 /// REVISION HISTORY:\n
 /// 15/04/13 : P.Jones - New file, first revision \n
 ///
-/// \detail  Displays a triangle for a fibre with a direction.
+/// \detail  Displays a triangle for a fibre with a direction. Each fibre
+///          type is a group in the frame's StaticScene.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -18,10 +19,10 @@
 #include <SFML/System/Vector3.hpp>
 
 #include <Viewer/Module3d.hh>
-#include <Viewer/VBO.hh>
 
 namespace Viewer
 {
+  class Colour;
 
 class Fibre3d : public Module3d
 {
@@ -39,30 +40,25 @@ public:
   /// Process event data
   virtual void ProcessEvent( const RenderState& renderState ) { };
   /// Process run data
-  virtual void ProcessRun();
-  /// Render all 3d objects
-  virtual void Render3d();
+  virtual void ProcessRun() { };
+  /// Add the fibres to the static scene
+  virtual void BuildStatic( StaticScene& scene );
+  /// Render all 3d objects, nothing to do here (see BuildStatic)
+  virtual void Render3d() { };
   /// Return the module name
   virtual std::string GetName() { return Fibre3d::Name(); }
   static std::string Name() { return std::string( "Fibre3d" ); }
 
 protected:
-  void AddPosVertices( VBO& vbo,
+  void AddPosVertices( StaticScene& scene,
                        const sf::Vector3<double>& pos,
                        const Colour& colour );
 
-  void AddDirVertices( VBO& vbo,
+  void AddDirVertices( StaticScene& scene,
                        const sf::Vector3<double>& pos,
                        const sf::Vector3<double>& dir,
                        const Colour& colour );
 
-  VBO fAMELLIEPos;
-  VBO fAMELLIEDir;
-  VBO fSMELLIEPos;
-  VBO fSMELLIEDir;
-  VBO fTELLIEPos;
-  VBO fTELLIEDir;
-
   bool fDisplayAMELLIE;
   bool fDisplaySMELLIE;
   bool fDisplayTELLIE;
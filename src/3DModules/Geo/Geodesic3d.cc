@@ -1,6 +1,7 @@
 #include <Viewer/Geodesic3d.hh>
 #include <Viewer/PersistLabel.hh>
 #include <Viewer/GeodesicSphere.hh>
+#include <Viewer/StaticScene.hh>
 #include <Viewer/GUIEvent.hh>
 #include <Viewer/ConfigurationTable.hh>
 using namespace Viewer;
@@ -38,9 +39,9 @@ Geodesic3d::PreInitialise( const ConfigurationTable* configTable )
 }
 
 void
-Geodesic3d::Render3d()
+Geodesic3d::BuildStatic( StaticScene& scene )
 {
-  if( !fDisplay )
-    return;
-  GeodesicSphere::GetInstance()->Render();
+  scene.NewGroup( fDisplay );
+  scene.AddVBO( StaticScene::eOccluders, GeodesicSphere::GetInstance()->FullVBO() );
+  scene.AddVBO( StaticScene::eDepthLines, GeodesicSphere::GetInstance()->OutlineVBO() );
 }
@@ -14,7 +14,8 @@
 ///          Geo manager module implementation that renders a geodesic
 ///          sphere. Utilizes the GeodesicSphere singleton to store the
 ///          VBOs necessary. A single GUI check box to enable or disable
-///          rendering the geometry. Standard geometry. \n
+///          rendering the geometry. Standard geometry, added to the
+///          frame's StaticScene rather than rendered by the module. \n
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -43,8 +44,10 @@ public:
   virtual void ProcessEvent( const RenderState& renderState ) { };
   /// Process run data
   virtual void ProcessRun() { };
-  /// Render all 3d objects
-  virtual void Render3d();
+  /// Add the geodesic sphere to the static scene
+  virtual void BuildStatic( StaticScene& scene );
+  /// Render all 3d objects, nothing to do here (see BuildStatic)
+  virtual void Render3d() { };
   /// Return the module name
   virtual std::string GetName() { return Geodesic3d::Name(); }
   static std::string Name() { return std::string( "Geodesic3d" ); }
@@ -1,5 +1,3 @@
-#include <TVector3.h>
-
 #include <Viewer/DefaultHits3d.hh>
 #include <Viewer/PersistLabel.hh>
 #include <Viewer/GUIEvent.hh>
@@ -7,6 +5,7 @@
 #include <Viewer/DataSelector.hh>
 #include <Viewer/GUIProperties.hh>
 #include <Viewer/RenderState.hh>
+#include <Viewer/StaticScene.hh>
 using namespace Viewer;
 #include <Viewer/RIDS/Event.hh>
 #include <Viewer/RIDS/ChannelList.hh>
@@ -61,55 +60,47 @@ DefaultHits3d::PreInitialise( const ConfigurationTable* configTable )
 void
 DefaultHits3d::ProcessEvent( const RenderState& renderState )
 {
-  fFullBuffer.Clear();
-  fOutlineBuffer.Clear();
-
+  fHitBuffer.SetScaling( renderState );
+  fHitBuffer.ClearHits();
   const std::vector<RIDS::Channel>& hits = DataSelector::GetInstance().GetData( renderState.GetDataSource(), renderState.GetDataType() );
-  const RIDS::ChannelList& channelList = DataSelector::GetInstance().GetChannelList();
-  for( int i = 0; i < hits.size(); i++ )
+  for( std::vector<RIDS::Channel>::const_iterator iTer = hits.begin(); iTer != hits.end(); iTer++ )
     {
-      if( hits[i].GetData() == 0 || hits[i].GetID() >= channelList.GetChannelCount() )
+      if( iTer->GetData() == 0 )
         continue;
-
-      const sf::Vector3<double> pp = channelList.GetPosition( hits[i].GetID() );
-      TVector3 p( pp.x, pp.y, pp.z );
-      Colour c = renderState.GetDataColour( hits[i].GetData() );
-
-      fFullBuffer.AddHitFull( p, c );
-      fOutlineBuffer.AddHitOutline( p, c );
+      fHitBuffer.AddHit( iTer->GetID(), iTer->GetData(), renderState );
     }
+  fHitBuffer.BindHits();
+}
 
-  fFullBuffer.Bind();
-  fOutlineBuffer.Bind();
-
+void
+DefaultHits3d::ProcessScaling( const RenderState& renderState )
+{
+  if( fHitBuffer.ValuesOnGPU() )
+    fHitBuffer.SetScaling( renderState ); // The uploaded values are unchanged
+  else
+    ProcessEvent( renderState );
 }
 
 void
 DefaultHits3d::ProcessRun()
 {
-  const RIDS::ChannelList& channelList = DataSelector::GetInstance().GetChannelList();
-  fPMTListBuffer.Clear();
-  for( int i=0; i < channelList.GetChannelCount(); i++ )
-    {
-      const sf::Vector3<double> pp = channelList.GetPosition( i );
-      TVector3 p( pp.x, pp.y, pp.z );
-      if( p.Mag2() > 0.0 )
-        fPMTListBuffer.AddHitOutline( p, GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ) );
-    }
-  fPMTListBuffer.Bind();
+  fHitBuffer.SetPositions( DataSelector::GetInstance().GetChannelList() );
+}
+
+void
+DefaultHits3d::BuildStatic( StaticScene& scene )
+{
+  scene.NewGroup( fDisplayAll );
+  scene.AddVBO( StaticScene::eDepthLines, fHitBuffer, GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ) );
 }
 
 void
 DefaultHits3d::Render3d()
 {
   if( !fDisplayFront )
-    fOutlineBuffer.Render( GL_LINES );
+    fHitBuffer.RenderOutline();
   
   glEnable( GL_DEPTH_TEST );
-
-  if( fDisplayAll )
-    fPMTListBuffer.Render( GL_LINES );
-  
-  fFullBuffer.Render( GL_TRIANGLES );
+  fHitBuffer.RenderFull();
   glDisable( GL_DEPTH_TEST );
 }
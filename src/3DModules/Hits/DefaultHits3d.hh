@@ -12,12 +12,14 @@
 /// \detail  Modification of the original DefaultHits3d class to take account
 ///          of codebase changes.
 ///             Filters hits if either the render state or the current EV
-///             changes. Stores each hit 2 ways, as a full hexagon and an
-///             outline of a hexagon in 2 seperate VBOs. The full hexagon hits
+///             changes. Draws each hit 2 ways, as a full hexagon and an
+///             outline of a hexagon from a single HitBuffer, the hexagons
+///             are built once per run. The full hexagon hits
 ///             are rendered with the depth buffer enabled, and the outline
 ///             hits are rendered with the depth buffer disabled to create
 ///             the effect that the hits in the back are outlines. Also has
-///             a mode where it all of the PMT array. \n 
+///             a mode where it all of the PMT array, this is static
+///             geometry in the frame's StaticScene. \n 
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -45,17 +47,19 @@ public:
   virtual void PostInitialise( const ConfigurationTable* configTable ) { };
   /// Process event data
   virtual void ProcessEvent( const RenderState& renderState );
+  /// Process a scaling or colour change only
+  virtual void ProcessScaling( const RenderState& renderState );
   /// Process run data
   virtual void ProcessRun();
+  /// Add the all PMT outline to the static scene
+  virtual void BuildStatic( StaticScene& scene );
   /// Render all 3d objects
   virtual void Render3d();
   /// Return the module name
   virtual std::string GetName() { return DefaultHits3d::Name(); }
   static std::string Name() { return std::string( "DefaultHits3d" ); }
 protected:
-  HitBuffer fPMTListBuffer; /// < VBO for all PMTs
-  HitBuffer fFullBuffer; /// < VBO for full PMTs 
-  HitBuffer fOutlineBuffer; /// < VBO for wireframe PMTs
+  HitBuffer fHitBuffer; /// < VBO for all PMTs and the hit PMTs
 
   bool fDisplayAll; /// Display all channels (even non hit ones)
   bool fDisplayFront; /// < Display only the front/nearest camera hits?
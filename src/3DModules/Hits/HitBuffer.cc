@@ -1,54 +1,167 @@
+#define GL_GLEXT_PROTOTYPES
+
 #include <iostream>
 #include <math.h>
 #include <TVector3.h>
 #include <TMath.h>
 #include <Viewer/Colour.hh>
 #include <Viewer/HitBuffer.hh>
+#include <Viewer/Shader3d.hh>
+#include <Viewer/RenderState.hh>
+#include <Viewer/RIDS/ChannelList.hh>
 
 #define SIDES 6
 #define RADIUS 140
 
 namespace Viewer {
 
-void HitBuffer::AddHitVertices( const TVector3& pos, const Colour& colour )
+HitBuffer::HitBuffer()
+    : fColourCapacity( 0 ), fValueCapacity( 0 ), fFullCapacity( 0 ), fOutlineCapacity( 0 ),
+      fFullVAOID( 0 ), fOutlineVAOID( 0 )
 {
-    TVector3 z = TVector3( 0, 0, 1 );
-    TVector3 p = pos.Unit();
+    fScaling[0] = 0.0;
+    fScaling[1] = 0.0;
+    glGenBuffers( 1, &fColourVBOID );
+    glGenBuffers( 1, &fValueVBOID );
+    glGenBuffers( 1, &fFullVBOID );
+    glGenBuffers( 1, &fOutlineVBOID );
+}
 
-    TVector3 axis = z.Cross( p );
-    double angle = acos( z * p  );
+HitBuffer::~HitBuffer()
+{
+    glDeleteBuffers( 1, &fColourVBOID );
+    glDeleteBuffers( 1, &fValueVBOID );
+    glDeleteBuffers( 1, &fFullVBOID );
+    glDeleteBuffers( 1, &fOutlineVBOID );
+    if( Shader3d::GetInstance().IsValid() )
+    {
+        glDeleteVertexArrays( 1, &fFullVAOID );
+        glDeleteVertexArrays( 1, &fOutlineVAOID );
+    }
+}
 
+void HitBuffer::SetPositions( const RIDS::ChannelList& channelList )
+{
+    Clear();
+    fValid.assign( channelList.GetChannelCount(), false );
+    const TVector3 z = TVector3( 0, 0, 1 );
+    for( int channel = 0; channel < channelList.GetChannelCount(); channel++ )
+    {
+        const sf::Vector3<double> position = channelList.GetPosition( channel );
+        const TVector3 pos( position.x, position.y, position.z );
+        const unsigned int b = fVertices.size();
+        if( pos.Mag2() > 0.0 )
+        {
+            fValid[channel] = true;
+            const TVector3 p = pos.Unit();
+            const TVector3 axis = z.Cross( p );
+            const double angle = acos( z * p );
+            for( int i = 0; i < SIDES; i++ )
+            {
+                double a = 2 * TMath::Pi() * i / SIDES;
+                TVector3 v = TVector3( RADIUS * sin(a), RADIUS * cos(a), pos.Mag() );
+                v.Rotate( angle, axis );
+                fVertices.push_back( Vertex( v, Colour() ).fData );
+            }
+            for( int i = 0; i < SIDES; i++ )
+            {
+                fIndices.push_back( b + i );
+                fIndices.push_back( b + ( i + 1 ) % SIDES );
+            }
+        }
+        else // Keep the channel to vertex mapping, never drawn
+            fVertices.resize( b + SIDES, Vertex( TVector3(), Colour() ).fData );
+    }
+    Bind();
+
+    if( ValuesOnGPU() )
+        fValues.assign( fVertices.size(), 0.0f );
+    else
+        fColours.assign( fVertices.size(), 0 );
+    ClearHits();
+}
+
+void HitBuffer::ClearHits()
+{
+    fFullIndices.clear();
+    fOutlineIndices.clear();
+}
+
+void HitBuffer::AddHit( int channel, double value, const RenderState& renderState )
+{
+    if( channel < 0 || channel >= static_cast<int>( fValid.size() ) || !fValid[channel] )
+        return;
+    const unsigned int b = channel * SIDES;
+    if( !fValues.empty() )
+    {
+        for( int i = 0; i < SIDES; i++ )
+            fValues[b + i] = static_cast<float>( value );
+    }
+    else
+    {
+        const sf::Uint32 packed = renderState.GetPackedDataColour( value );
+        for( int i = 0; i < SIDES; i++ )
+            fColours[b + i] = packed;
+    }
+    for( int i = 1; i < SIDES - 1; i++ )
+    {
+        fFullIndices.push_back( b );
+        fFullIndices.push_back( b + i );
+        fFullIndices.push_back( b + i + 1 );
+    }
     for( int i = 0; i < SIDES; i++ )
     {
-        double a = 2 * TMath::Pi() * i / SIDES;
-        TVector3 v = TVector3( RADIUS * sin(a), RADIUS * cos(a), pos.Mag() );
-        v.Rotate( angle, axis );
-        fVertices.push_back( Vertex(v,colour).fData );
+        fOutlineIndices.push_back( b + i );
+        fOutlineIndices.push_back( b + ( i + 1 ) % SIDES );
     }
+}
+
+void HitBuffer::BindHits()
+{
+    // Colours (values) of unhit channels are stale but never indexed
+    if( !fValues.empty() )
+        Upload( GL_ARRAY_BUFFER, fValueVBOID, &fValues[0], fValues.size() * sizeof( float ), fValueCapacity );
+    else if( !fColours.empty() )
+        Upload( GL_ARRAY_BUFFER, fColourVBOID, &fColours[0], fColours.size() * sizeof( sf::Uint32 ), fColourCapacity );
+    else
+        return;
+    Upload( GL_ELEMENT_ARRAY_BUFFER, fFullVBOID, fFullIndices.empty() ? NULL : &fFullIndices[0], fFullIndices.size() * sizeof( GLuint ), fFullCapacity );
+    Upload( GL_ELEMENT_ARRAY_BUFFER, fOutlineVBOID, fOutlineIndices.empty() ? NULL : &fOutlineIndices[0], fOutlineIndices.size() * sizeof( GLuint ), fOutlineCapacity );
+}
 
+void HitBuffer::SetScaling( const RenderState& renderState )
+{
+    fScaling[0] = renderState.GetScalingMin();
+    fScaling[1] = renderState.GetScalingMax();
+    if( ValuesOnGPU() )
+        Shader3d::GetInstance().SetPalette();
+}
 
+bool HitBuffer::ValuesOnGPU() const
+{
+    return Shader3d::GetInstance().IsValid();
 }
 
-void HitBuffer::AddHitFull( const TVector3& pos, const Colour& colour )
+void HitBuffer::RenderFull() const
 {
-    unsigned int b = fVertices.size();
-    AddHitVertices( pos, colour );
-    fIndices.push_back(b+0);    fIndices.push_back(b+1);    fIndices.push_back(b+2);
-    fIndices.push_back(b+0);    fIndices.push_back(b+2);    fIndices.push_back(b+3);
-    fIndices.push_back(b+0);    fIndices.push_back(b+3);    fIndices.push_back(b+4);
-    fIndices.push_back(b+0);    fIndices.push_back(b+4);    fIndices.push_back(b+5);
+    if( fValues.empty() )
+        Draw( GL_TRIANGLES, fFullIndices.size(), fFullVAOID, fColourVBOID, 0, 0, fFullVBOID );
+    else
+    {
+        Shader3d::GetInstance().SetScaling( fScaling[0], fScaling[1] );
+        Draw( GL_TRIANGLES, fFullIndices.size(), fFullVAOID, 0, 0, 0, fFullVBOID, fValueVBOID );
+    }
 }
 
-void HitBuffer::AddHitOutline( const TVector3& pos, const Colour& colour )
+void HitBuffer::RenderOutline() const
 {
-    unsigned int b = fVertices.size();
-    AddHitVertices( pos, colour );
-    fIndices.push_back(b+0);    fIndices.push_back(b+1);
-    fIndices.push_back(b+1);    fIndices.push_back(b+2);
-    fIndices.push_back(b+2);    fIndices.push_back(b+3);
-    fIndices.push_back(b+3);    fIndices.push_back(b+4);
-    fIndices.push_back(b+4);    fIndices.push_back(b+5);
-    fIndices.push_back(b+5);    fIndices.push_back(b+0);
+    if( fValues.empty() )
+        Draw( GL_LINES, fOutlineIndices.size(), fOutlineVAOID, fColourVBOID, 0, 0, fOutlineVBOID );
+    else
+    {
+        Shader3d::GetInstance().SetScaling( fScaling[0], fScaling[1] );
+        Draw( GL_LINES, fOutlineIndices.size(), fOutlineVAOID, 0, 0, 0, fOutlineVBOID, fValueVBOID );
+    }
 }
 
 }; // namespace Viewer
@@ -8,28 +8,73 @@
 /// REVISION HISTORY:\n
 ///     01/05/12 : O.Wasalski - First Revision, new file. \n
 ///
-/// \detail  Wraps the creation of the hexagons for each hit in methods
-///          detailing the creation of either a full or outline hexagon.
-///          Rendering is done using the parent VBO class. \n
+/// \detail  Creates a hexagon for every channel once per run (SetPositions),
+///          these vertices stay on the GPU. Per event only the hit channel
+///          colours (a packed RGBA word per vertex) and the indices of the
+///          hit channels, as full and outline hexagons, are uploaded. The
+///          base VBO indices hold the outline of every channel (drawn via
+///          the StaticScene). If the
+///          Shader3d programs are valid the raw hit values are uploaded
+///          instead of colours and the scaling is a uniform, so a scaling
+///          or palette change (SetScaling) uploads nothing. \n
 ///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef __Viewer_HitBuffer__
 #define __Viewer_HitBuffer__
 
-class TVector3;
+#include <vector>
+
+#include <SFML/Config.hpp>
+
 #include <Viewer/VBO.hh>
 
 namespace Viewer {
-    class Colour;
+    class RenderState;
+namespace RIDS
+{
+    class ChannelList;
+}
 
 class HitBuffer : public VBO {
 public:
-    void AddHitFull( const TVector3& pos, const Colour& colour );
-    void AddHitOutline( const TVector3& pos, const Colour& colour );
+    HitBuffer();
+    ~HitBuffer();
+
+    /// Build and upload the hexagon for every channel, call once per run
+    void SetPositions( const RIDS::ChannelList& channelList );
+    /// Clear the hits, call before adding the event hits
+    void ClearHits();
+    /// Add a hit on the channel, coloured by the render state
+    void AddHit( int channel, double value, const RenderState& renderState );
+    /// Upload the hit colours (or values) and indices
+    void BindHits();
+    /// Set the scaling and palette, only effective if ValuesOnGPU (else the hits must be re-added)
+    void SetScaling( const RenderState& renderState );
+    /// Return true if the scaling and palette are applied on the GPU
+    bool ValuesOnGPU() const;
 
+    /// Render the hits as full hexagons
+    void RenderFull() const;
+    /// Render the hits as outline hexagons
+    void RenderOutline() const;
 private:
-    void AddHitVertices( const TVector3& pos, const Colour& colour );
+    std::vector<sf::Uint32> fColours; /// < Packed colour per vertex
+    std::vector<float> fValues; /// < Hit value per vertex, if ValuesOnGPU
+    std::vector<GLuint> fFullIndices; /// < Hit triangle indices
+    std::vector<GLuint> fOutlineIndices; /// < Hit line indices
+    std::vector<bool> fValid; /// < Channel has a position
+    GLuint fColourVBOID;
+    GLuint fValueVBOID;
+    GLuint fFullVBOID;
+    GLuint fOutlineVBOID;
+    size_t fColourCapacity; /// < Bytes allocated for the colours
+    size_t fValueCapacity; /// < Bytes allocated for the values
+    double fScaling[2]; /// < Scaling min, max for the value program
+    size_t fFullCapacity; /// < Bytes allocated for the hit triangle indices
+    size_t fOutlineCapacity; /// < Bytes allocated for the hit line indices
+    mutable GLuint fFullVAOID; /// < Vertex array objects, built on first render
+    mutable GLuint fOutlineVAOID;
 };
 
 } // namespace Viewer
@@ -30,6 +30,7 @@ namespace Viewer
 {
   class ConfigurationTable;
   class RenderState;
+  class StaticScene;
 
 class Module3d 
 {
@@ -49,8 +50,12 @@ public:
   virtual void PostInitialise( const ConfigurationTable* configTable ) = 0;
   /// Process event data
   virtual void ProcessEvent( const RenderState& renderState ) = 0;
+  /// Process a scaling or colour change only, by default reprocess the event
+  virtual void ProcessScaling( const RenderState& renderState ) { ProcessEvent( renderState ); }
   /// Process run data
   virtual void ProcessRun() = 0;
+  /// Add the static (per run) geometry to the frame's scene, called after ProcessRun
+  virtual void BuildStatic( StaticScene& scene ) { }
   /// Render all 3d objects
   virtual void Render3d() = 0;
   /// Return the module name
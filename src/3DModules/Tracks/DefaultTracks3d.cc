@@ -16,7 +16,8 @@ DefaultTracks3d::EventLoop()
         {
           GUIs::PersistLabel* button = dynamic_cast<GUIs::PersistLabel*>( fGUIManager.GetGUI( fEvents.front().fguiID ) );
           fDisplayParticle[button->GetLabel()] = button->GetState();
-          fTrackBuffer.fParticleTypes[button->GetLabel()].fVisible = button->GetState();
+          if( fTrackBuffer.SetVisible( button->GetLabel(), button->GetState() ) )
+            fTrackBuffer.SetAll( DataSelector::GetInstance().GetEvent() ); // Hidden types are not built
         }
       fEvents.pop();
     }
@@ -60,6 +61,7 @@ DefaultTracks3d::PreInitialise( const ConfigurationTable* configTable )
       GUIs::PersistLabel* button = dynamic_cast<GUIs::PersistLabel*>( fGUIManager.NewGUI<GUIs::PersistLabel>( size ) );
       button->Initialise( 16, *iTer );
       button->SetState( fDisplayParticle[*iTer] );
+      fTrackBuffer.SetVisible( *iTer, fDisplayParticle[*iTer] );
     }
 }
 
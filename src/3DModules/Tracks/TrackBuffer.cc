@@ -1,17 +1,28 @@
+#include <algorithm>
+
 #include <Viewer/ConfigTableUtils.hh>
 #include <Viewer/GUIProperties.hh>
 #include <Viewer/TrackBuffer.hh>
+#include <Viewer/FramePacer.hh>
 
 #include <Viewer/RIDS/Track.hh>
 #include <Viewer/RIDS/Event.hh>
 
 namespace Viewer {
 
+TrackBuffer::~TrackBuffer()
+{
+    Scheduler::GetInstance().Cancel( fBuildTask );
+    delete fPending;
+    delete fBuilt;
+}
+
 void TrackBuffer::AddParticleType( const std::string& name, float colour )
 {
     struct ParticleType p;
     p.fColour = colour;
     p.fVisible = true;
+    p.fBuilt = false;
     fParticleTypes[ name ] = p;
 }
 
@@ -38,29 +49,98 @@ void TrackBuffer::SaveVisibility( ConfigurationTable* configTable )
         ConfigTableUtils::SetBoolean( configTable, itr->first, itr->second.fVisible );
 }
 
-void TrackBuffer::SetAll( const RIDS::Event& event )
+bool TrackBuffer::SetVisible( const std::string& name, bool visible )
 {
-    ClearAll();
+    std::map< std::string, struct ParticleType >::iterator found = fParticleTypes.find( name );
+    if( found == fParticleTypes.end() )
+        return false;
+    found->second.fVisible = visible;
+    return visible && !found->second.fBuilt;
+}
 
+void TrackBuffer::SetAll( const RIDS::Event& event )
+{
+    // Select the tracks of the visible types, grouped by type
+    std::map< std::string, std::vector<size_t> > selected;
     const std::vector< RIDS::Track >& tracks = event.GetTracks();
-    for( int i = 0; i < tracks.size(); i++ )
+    for( size_t i = 0; i < tracks.size(); i++ )
+    {
+        const std::string& type = GetType( tracks[i].GetParticleName() );
+        std::map< std::string, struct ParticleType >::const_iterator found = fParticleTypes.find( type );
+        if( found == fParticleTypes.end() || !found->second.fVisible || tracks[i].GetTrackSteps().empty() )
+            continue;
+        selected[type].push_back( i );
+    }
+
+    Build* build = new Build();
+    std::map< std::string, struct ParticleType >::iterator itr;
+    for( itr = fParticleTypes.begin(); itr != fParticleTypes.end(); itr++)
+        itr->second.fBuilt = itr->second.fVisible;
+    std::map< std::string, std::vector<size_t> >::iterator sItr;
+    for( sItr = selected.begin(); sItr != selected.end(); sItr++ )
     {
-        const std::string& name = tracks[i].GetParticleName();
-        struct ParticleType& pt = fParticleTypes[ name ];
-        const Colour& c = GUIProperties::GetInstance().GetColourPalette().GetColour( pt.fColour );
-        const std::vector< RIDS::TrackStep >& trackSteps = tracks[i].GetTrackSteps();
-        
-        AddLine( pt.fSimpleVBO, trackSteps[0].GetEndPos(), trackSteps[ trackSteps.size() - 1 ].GetEndPos(), c );
-
-        for( int i = 0; i < trackSteps.size() - 1; i++ )
-            AddLine( pt.fAllStepsVBO, trackSteps[i].GetEndPos(), trackSteps[i+1].GetEndPos(), c );
+        std::vector<size_t>& indices = sItr->second;
+        if( indices.size() > kMaxTracks )
+        {
+            // Reservoir sample, seeded by the count so that an event always draws the same tracks
+            unsigned int seed = indices.size();
+            for( size_t i = kMaxTracks; i < indices.size(); i++ )
+            {
+                seed = seed * 1103515245u + 12345u;
+                const size_t j = ( seed >> 8 ) % ( i + 1 );
+                if( j < kMaxTracks )
+                    indices[j] = indices[i];
+            }
+            indices.resize( kMaxTracks );
+            std::sort( indices.begin(), indices.end() );
+        }
+        build->fColours[sItr->first] = GUIProperties::GetInstance().GetColourPalette().GetColour( fParticleTypes[sItr->first].fColour );
+        for( size_t i = 0; i < indices.size(); i++ )
+        {
+            build->fTracks.push_back( tracks[indices[i]] );
+            build->fTypes.push_back( sItr->first );
+        }
     }
 
-    BindAll();
+    {
+        Lock lock( fLock );
+        delete fPending; // Superseded, never built
+        fPending = build;
+    }
+    Scheduler::GetInstance().Submit( fBuildTask );
+}
+
+void TrackBuffer::BuildPending()
+{
+    Build* build = NULL;
+    {
+        Lock lock( fLock );
+        build = fPending;
+        fPending = NULL;
+    }
+    if( build == NULL ) // Already built
+        return;
+    BuildGeometry( *build );
+    Lock lock( fLock );
+    delete fBuilt; // Superseded, never uploaded
+    fBuilt = build;
+    FramePacer::GetInstance().Invalidate(); // Render uploads it
 }
 
 void TrackBuffer::Render( bool renderAllSteps )
 {
+    Build* built = NULL;
+    {
+        Lock lock( fLock );
+        built = fBuilt;
+        fBuilt = NULL;
+    }
+    if( built != NULL )
+    {
+        BindAll( *built );
+        delete built;
+    }
+
     std::map< std::string, struct ParticleType >::iterator itr;
     for( itr = fParticleTypes.begin(); itr != fParticleTypes.end(); itr++) 
     {
@@ -74,33 +154,56 @@ void TrackBuffer::Render( bool renderAllSteps )
     }   
 }
 
-void TrackBuffer::ClearAll()
+const std::string& TrackBuffer::GetType( const std::string& particleName ) const
 {
-    std::map< std::string, struct ParticleType >::iterator itr;
-    for( itr = fParticleTypes.begin(); itr != fParticleTypes.end(); itr++) 
+    static const std::string unknown( "unknown" );
+    if( fParticleTypes.count( particleName ) == 0 && fParticleTypes.count( unknown ) > 0 )
+        return unknown;
+    return particleName;
+}
+
+void TrackBuffer::BuildGeometry( Build& build )
+{
+    for( size_t i = 0; i < build.fTracks.size(); i++ )
     {
-        itr->second.fSimpleVBO.Clear();
-        itr->second.fAllStepsVBO.Clear();
+        const Colour& c = build.fColours[ build.fTypes[i] ];
+        Geometry& geometry = build.fGeometry[ build.fTypes[i] ];
+        const std::vector< RIDS::TrackStep >& trackSteps = build.fTracks[i].GetTrackSteps();
+
+        AddLine( geometry.fSimpleVertices, geometry.fSimpleIndices, trackSteps[0].GetEndPos(), trackSteps[ trackSteps.size() - 1 ].GetEndPos(), c );
+
+        for( size_t j = 0; j + 1 < trackSteps.size(); j++ )
+            AddLine( geometry.fAllStepsVertices, geometry.fAllStepsIndices, trackSteps[j].GetEndPos(), trackSteps[j+1].GetEndPos(), c );
     }
 }
 
-void TrackBuffer::BindAll()
+void TrackBuffer::BindAll( Build& build )
 {
     std::map< std::string, struct ParticleType >::iterator itr;
     for( itr = fParticleTypes.begin(); itr != fParticleTypes.end(); itr++) 
     {
+        itr->second.fSimpleVBO.Clear();
+        itr->second.fAllStepsVBO.Clear();
+        std::map< std::string, Geometry >::iterator found = build.fGeometry.find( itr->first );
+        if( found != build.fGeometry.end() )
+        {
+            itr->second.fSimpleVBO.fVertices.swap( found->second.fSimpleVertices );
+            itr->second.fSimpleVBO.fIndices.swap( found->second.fSimpleIndices );
+            itr->second.fAllStepsVBO.fVertices.swap( found->second.fAllStepsVertices );
+            itr->second.fAllStepsVBO.fIndices.swap( found->second.fAllStepsIndices );
+        }
         itr->second.fSimpleVBO.Bind();
         itr->second.fAllStepsVBO.Bind();
     }
 }
 
-void TrackBuffer::AddLine( VBO& vbo, const TVector3& startPos, const TVector3& endPos, const Colour& colour )
+void TrackBuffer::AddLine( std::vector<Vertex::Data>& vertices, std::vector<GLuint>& indices, const TVector3& startPos, const TVector3& endPos, const Colour& colour )
 {
-    unsigned short i = vbo.fVertices.size();
-    vbo.AddVertex( Vertex( startPos, colour ) );
-    vbo.AddVertex( Vertex( endPos, colour ) );
-    vbo.AddIndex(i);
-    vbo.AddIndex(i+1);
+    GLuint i = vertices.size();
+    vertices.push_back( Vertex( startPos, colour ).fData );
+    vertices.push_back( Vertex( endPos, colour ).fData );
+    indices.push_back(i);
+    indices.push_back(i+1);
 }
 
 }; // namespace Viewer 
@@ -9,7 +9,11 @@
 /// REVISION HISTORY:\n
 ///     May 23, 2012 : O.Wasalski - First Revision, new file. \n
 ///
-/// \detail  As brief
+/// \detail  SetAll copies the tracks of the visible particle types, at
+///          most kMaxTracks per type (randomly sampled, e.g. optical
+///          photons in a shower), and queues them. A Scheduler task builds
+///          the vertices and indices, the next Render uploads them to the
+///          VBOs. Only the latest queued event is built.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -18,8 +22,13 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <Viewer/VisAttributes.hh>
 #include <Viewer/VBO.hh>
+#include <Viewer/Colour.hh>
+#include <Viewer/Mutex.hh>
+#include <Viewer/Scheduler.hh>
+#include <Viewer/RIDS/Track.hh>
 
 namespace Viewer {
     namespace RIDS {
@@ -31,27 +40,59 @@ namespace Viewer {
 class TrackBuffer {
 
 public:
+    /// Maximum tracks drawn per particle type
+    static const size_t kMaxTracks = 2000;
+
     struct ParticleType {
         bool fVisible;
+        bool fBuilt; /// < Built in the latest SetAll
         float fColour;
         VBO fAllStepsVBO;
         VBO fSimpleVBO;
     }; // struct ParticleType
 
+    TrackBuffer() : fPending( NULL ), fBuilt( NULL ), fBuildTask( "TrackBuffer::Build", *this, &TrackBuffer::BuildPending ) { }
+    ~TrackBuffer();
+
     void AddParticleType( const std::string& name, float colour );
     std::vector< std::string > GetNames();
     void LoadVisibility( const ConfigurationTable* configTable );
     void SaveVisibility( ConfigurationTable* configTable );
+    /// Set the particle type visibility, returns true if SetAll must be called again (type not built)
+    bool SetVisible( const std::string& name, bool visible );
     void SetAll( const RIDS::Event& event );
     void Render( bool renderAllSteps );
 
     std::map< std::string, struct ParticleType > fParticleTypes;
 
 private:
-    void ClearAll();
-    void BindAll();
-    void AddLine( VBO& vbo, const TVector3& startPos, const TVector3& endPos, const Colour& colour );
+    /// Geometry of a particle type
+    struct Geometry {
+        std::vector<Vertex::Data> fAllStepsVertices;
+        std::vector<GLuint> fAllStepsIndices;
+        std::vector<Vertex::Data> fSimpleVertices;
+        std::vector<GLuint> fSimpleIndices;
+    }; // struct Geometry
+    /// Tracks to build and the built geometry
+    struct Build {
+        std::vector< RIDS::Track > fTracks;
+        std::vector< std::string > fTypes; /// < Particle type per track
+        std::map< std::string, Colour > fColours; /// < Colour per particle type
+        std::map< std::string, Geometry > fGeometry;
+    }; // struct Build
     
+    /// Build the queued tracks. Called by the build task ONLY
+    void BuildPending();
+    /// Return the particle type name for the track particle name
+    const std::string& GetType( const std::string& particleName ) const;
+    void BuildGeometry( Build& build );
+    void BindAll( Build& build );
+    void AddLine( std::vector<Vertex::Data>& vertices, std::vector<GLuint>& indices, const TVector3& startPos, const TVector3& endPos, const Colour& colour );
+
+    Build* fPending; /// < Tracks awaiting the build
+    Build* fBuilt; /// < Built geometry awaiting upload
+    Mutex fLock; /// < Guards fPending and fBuilt
+    MethodTask<TrackBuffer> fBuildTask; /// < Runs BuildPending
 };
 
 } // namespace Viewer
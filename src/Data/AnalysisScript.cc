@@ -6,6 +6,7 @@ using namespace std;
 
 #include <Viewer/AnalysisScript.hh>
 #include <Viewer/DataSelector.hh>
+#include <Viewer/Profiler.hh>
 using namespace Viewer;
 #include <Viewer/RIDS/Event.hh>
 #include <Viewer/RIDS/ChannelList.hh>
@@ -119,6 +120,7 @@ AnalysisScript::PyToRIDS()
 void
 AnalysisScript::ProcessEvent( const RIDS::Event& event )
 {
+  Profiler::Scope scope( "AnalysisScript::ProcessEvent" );
   const RIDS::ChannelList& channelList = DataSelector::GetInstance().GetChannelList();
 
   // First convert the event structure into a python structure
@@ -0,0 +1,178 @@
+#include <vector>
+#include <string>
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/CrateSummary.hh>
+#include <Viewer/BitManip.hh>
+using namespace Viewer;
+#include <Viewer/RIDS/Event.hh>
+
+const int kMaxDuration = 24 * 60 * 60; // Seconds in a day, longer differences are across dates
+
+CrateSummary::CrateSummary()
+{
+  Clear();
+}
+
+void
+CrateSummary::Clear()
+{
+  const int sizes[3] = { kCrates, kCrates * kCards, kCrates * kCards * kChannels };
+  Cell empty = { 0, 0.0 };
+  for( int iLevel = 0; iLevel < 3; iLevel++ )
+    {
+      fCurrent[iLevel].assign( sizes[iLevel], empty );
+      fLast[iLevel].assign( sizes[iLevel], empty );
+    }
+  fWindowCount = 0;
+  fLastDuration = 1;
+  fSource = -1;
+  fChargeType = -1;
+}
+
+void
+CrateSummary::AddEvent( const RIDS::Event& event )
+{
+  if( fSource == -1 )
+    {
+      FindSource();
+      fWindowStart = event.GetTime();
+      fLatest = event.GetTime();
+    }
+  const int elapsed = event.GetTime() - fWindowStart;
+  if( elapsed >= 1 ) // The window spans until this event, including any gap without events
+    {
+      CloseWindow( elapsed );
+      fWindowStart = event.GetTime();
+    }
+  else if( elapsed < 0 ) // Time has gone backwards, e.g. new file, so the window ends at the latest event
+    {
+      CloseWindow( fLatest - fWindowStart );
+      fWindowStart = event.GetTime();
+    }
+  fLatest = event.GetTime();
+
+  const RIDS::Source& source = event.GetSource( fSource );
+  const vector<RIDS::Channel>& hits = source.GetData( 0 );
+  for( size_t iHit = 0; iHit < hits.size(); iHit++ )
+    {
+      const int lcn = hits[iHit].GetID();
+      const int crate = BitManip::GetBits( lcn, 9, 5 );
+      if( lcn < 0 || crate >= kCrates )
+        continue;
+      const int card = BitManip::GetBits( lcn, 5, 4 );
+      const int channel = BitManip::GetBits( lcn, 0, 5 );
+      double charge = 0.0;
+      if( fChargeType != -1 )
+        charge = source.GetType( fChargeType ).GetChannel( iHit ).GetData();
+      const int indices[3] = { crate, GetIndex( eCard, crate, card, channel ), GetIndex( eChannel, crate, card, channel ) };
+      for( int iLevel = 0; iLevel < 3; iLevel++ )
+        {
+          fCurrent[iLevel][indices[iLevel]].fHits++;
+          fCurrent[iLevel][indices[iLevel]].fCharge += charge;
+        }
+    }
+}
+
+double
+CrateSummary::GetRate( ELevel level,
+                       int crate,
+                       int card,
+                       int channel ) const
+{
+  // Until a window has completed show the partial window
+  const vector<Cell>& cells = fWindowCount == 0 ? fCurrent[level] : fLast[level];
+  return static_cast<double>( cells[GetIndex( level, crate, card, channel )].fHits ) / GetDuration();
+}
+
+double
+CrateSummary::GetMeanCharge( ELevel level,
+                             int crate,
+                             int card,
+                             int channel ) const
+{
+  const vector<Cell>& cells = fWindowCount == 0 ? fCurrent[level] : fLast[level];
+  const Cell& cell = cells[GetIndex( level, crate, card, channel )];
+  if( cell.fHits == 0 )
+    return 0.0;
+  return cell.fCharge / static_cast<double>( cell.fHits );
+}
+
+double
+CrateSummary::GetMaxRate( ELevel level,
+                          int crate ) const
+{
+  const vector<Cell>& cells = fWindowCount == 0 ? fCurrent[level] : fLast[level];
+  size_t start = 0;
+  size_t end = cells.size();
+  if( crate >= 0 )
+    {
+      start = GetIndex( level, crate, 0, 0 );
+      end = start + cells.size() / kCrates;
+    }
+  unsigned int maxHits = 0;
+  for( size_t iCell = start; iCell < end; iCell++ )
+    maxHits = max( maxHits, cells[iCell].fHits );
+  return static_cast<double>( maxHits ) / GetDuration();
+}
+
+double
+CrateSummary::GetDuration() const
+{
+  if( fSource == -1 ) // No events
+    return 1.0;
+  if( fWindowCount == 0 )
+    {
+      const int duration = fLatest - fWindowStart;
+      return duration >= 1 && duration < kMaxDuration ? static_cast<double>( duration ) : 1.0;
+    }
+  return static_cast<double>( fLastDuration );
+}
+
+int
+CrateSummary::GetIndex( ELevel level,
+                        int crate,
+                        int card,
+                        int channel ) const
+{
+  switch( level )
+    {
+    case eCrate:
+      return crate;
+    case eCard:
+      return crate * kCards + card;
+    default:
+      return ( crate * kCards + card ) * kChannels + channel;
+    }
+}
+
+void
+CrateSummary::CloseWindow( int duration )
+{
+  Cell empty = { 0, 0.0 };
+  for( int iLevel = 0; iLevel < 3; iLevel++ )
+    {
+      fLast[iLevel].swap( fCurrent[iLevel] );
+      fill( fCurrent[iLevel].begin(), fCurrent[iLevel].end(), empty );
+    }
+  // At least a second, as the times have one second resolution. Time differences across dates are
+  // INT_MAX, so the duration is unknown and the window is taken as a second.
+  fLastDuration = duration >= 1 && duration < kMaxDuration ? duration : 1;
+  fWindowCount++;
+}
+
+void
+CrateSummary::FindSource()
+{
+  // Prefer the uncalibrated data, as this is what the detector delivers
+  fSource = 0;
+  const vector<string> sourceNames = RIDS::Event::GetSourceNames();
+  for( size_t iSource = 0; iSource < sourceNames.size(); iSource++ )
+    if( sourceNames[iSource] == "UnCal" )
+      fSource = iSource;
+  const vector<string> typeNames = RIDS::Event::GetTypeNames( fSource );
+  vector<string>::const_iterator charge = find( typeNames.begin(), typeNames.end(), "QHL" );
+  if( charge != typeNames.end() )
+    fChargeType = charge - typeNames.begin();
+}
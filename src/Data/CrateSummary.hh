@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::CrateSummary
+///
+/// \brief   Aggregated per crate, card and channel hit rates and charge
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  The DataStore adds every event to this summary as it is
+///          ingested. Hits and summed charge are held in a
+///          crate x card x channel cube, with the card and crate totals
+///          kept alongside so that no summation is required to render.
+///          Counts are accumulated in windows of event time, closed by the
+///          first event at least one second after the window started. The
+///          last completed window is published, divided by its duration to
+///          give the rate (Hz), such that gaps in the data lower the rate.
+///          The DataStore clears the summary when the run changes.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_CrateSummary__
+#define __Viewer_CrateSummary__
+
+#include <vector>
+
+#include <Viewer/RIDS/Time.hh>
+
+namespace Viewer
+{
+namespace RIDS
+{
+  class Event;
+}
+
+class CrateSummary
+{
+public:
+  enum ELevel { eCrate, eCard, eChannel };
+  static const int kCrates = 20;
+  static const int kCards = 16;
+  static const int kChannels = 32;
+
+  CrateSummary();
+  /// Add an event's hits to the current window
+  void AddEvent( const RIDS::Event& event );
+  /// Clear all windows
+  void Clear();
+
+  /// Return the hit rate (Hz) for the crate, card or channel at this level
+  double GetRate( ELevel level, int crate, int card = 0, int channel = 0 ) const;
+  /// Return the mean charge per hit for the crate, card or channel at this level
+  double GetMeanCharge( ELevel level, int crate, int card = 0, int channel = 0 ) const;
+  /// Return the maximum rate at this level, optionally limited to a single crate
+  double GetMaxRate( ELevel level, int crate = -1 ) const;
+  /// Return the number of completed windows, changes when the rates change
+  int GetWindowCount() const { return fWindowCount; }
+private:
+  struct Cell
+  {
+    unsigned int fHits; /// < Number of hits
+    double fCharge; /// < Summed charge
+  };
+  /// Return the cell index given the level and location
+  int GetIndex( ELevel level, int crate, int card, int channel ) const;
+  /// Close the current window of duration seconds, publish it and start a new window
+  void CloseWindow( int duration );
+  /// Return the duration (seconds) of the published window, or the current window if none has completed
+  double GetDuration() const;
+  /// Find the source and type indices to summarise
+  void FindSource();
+
+  std::vector<Cell> fCurrent[3]; /// < Cells being accumulated, per level
+  std::vector<Cell> fLast[3]; /// < Cells of the last completed window, per level
+  RIDS::Time fWindowStart; /// < Event time the current window started
+  RIDS::Time fLatest; /// < Event time of the latest event
+  int fLastDuration; /// < Duration (seconds) of the last completed window
+  int fWindowCount; /// < Number of completed windows
+  int fSource; /// < Source index to summarise, -1 if not yet known
+  int fChargeType; /// < Charge type index in the source, -1 if none
+};
+
+} //::Viewer
+
+#endif
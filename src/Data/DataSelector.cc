@@ -1,4 +1,5 @@
 #include <vector>
+#include <algorithm>
 using namespace std;
 
 #include <Viewer/DataSelector.hh>
@@ -69,8 +70,11 @@ DataSelector::PeekEvent( int step ) const
 void 
 DataSelector::Latest()
 {
+  // Bounded, as the buffer is a ring, such that events that never go back in time cannot loop forever
+  const DataStore& dataStore = DataStore::GetInstance();
+  const size_t buffered = std::min( dataStore.GetBufferSize(), dataStore.GetEventsAdded() );
   bool advancing = true; // Advancing in time?
-  while( advancing )
+  for( size_t step = 1; advancing && step < buffered; step++ )
     {
       RIDS::Time currentTime = fEvent->GetTime();
       Move( +1 );
@@ -32,6 +32,7 @@ DataStore::DataStore()
   fWrite = 0;
   fRead = 0;
   fEventsAdded = 0;
+  fSummaryRunID = -1;
 }
 
 void
@@ -63,9 +64,9 @@ DataStore::AddEvent( RIDS::Event* event )
 void 
 DataStore::Update()
 {
-  /// This will overwrite existing events
+  /// This will overwrite existing events, but at most a buffer's worth such that none added are lost
   RIDS::Event* currentEvent = NULL;
-  while( fInputBuffer.Pop( currentEvent ) )
+  for( size_t added = 0; added < fEvents.size() && fInputBuffer.Pop( currentEvent ); added++ )
     {
       fEventsAdded++;
       delete fEvents[fWrite];
@@ -82,6 +83,13 @@ DataStore::Update()
           fibreList->Initialise( runID );
           fFibreLists[runID] = fibreList;
         }
+      if( runID != fSummaryRunID ) // New run, the sources and rates may differ
+        {
+          fCrateSummary.Clear();
+          fSummaryRunID = runID;
+        }
+      fCrateSummary.AddEvent( *currentEvent );
+      fStreamSummary.AddEvent( *currentEvent );
       fEvents[fWrite] = currentEvent;
       fWrite = AdjustIndex( fWrite, fEvents.size(), 1 );
     }
@@ -29,6 +29,8 @@
 #include <map>
 
 #include <Viewer/InputBuffer.hh>
+#include <Viewer/CrateSummary.hh>
+#include <Viewer/StreamSummary.hh>
 
 namespace Viewer
 {
@@ -50,7 +52,7 @@ public:
   virtual ~DataStore();
   /// Add an event, this is called by the Data Thread ONLY, return true on success
   bool AddEvent( RIDS::Event* event );
-  /// Update, moves events from the input buffer to the available buffer
+  /// Update, moves events from the input buffer to the available buffer, at most the buffer size
   void Update();
   /// Move to the event step away
   void Move( RIDS::Event* event, 
@@ -64,6 +66,10 @@ public:
   size_t GetBufferElements() const { return fInputBuffer.GetNumElements(); }
   size_t GetBufferSize() const { return fEvents.size(); }
   size_t GetEventsAdded() const { return fEventsAdded; }
+  /// Return the crate summary of all ingested events
+  const CrateSummary& GetCrateSummary() const { return fCrateSummary; }
+  /// Return the rolling stream counts of all ingested events
+  const StreamSummary& GetStreamSummary() const { return fStreamSummary; }
 private:
   InputBuffer<RIDS::Event*> fInputBuffer; /// < The input buffer, events arrive here
   std::map<int, RIDS::ChannelList*> fChannelLists; /// < ChannelLists mapped by run ID
@@ -72,6 +78,9 @@ private:
   size_t fRead; /// < The currently read position in fEvents
   size_t fWrite; /// < The current write position in fEvents
   int fEventsAdded; /// < Count of added events 
+  CrateSummary fCrateSummary; /// < Aggregated rates, updated as events are ingested
+  int fSummaryRunID; /// < Run ID fCrateSummary holds, -1 if none
+  StreamSummary fStreamSummary; /// < Rolling per second counts, updated as events are ingested
 
   /// Prevent usage of methods below
   DataStore();
@@ -0,0 +1,185 @@
+#include <TVector3.h>
+
+#include <SFML/System/Vector3.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/EventGenerator.hh>
+using namespace Viewer;
+#include <Viewer/RIDS/Event.hh>
+#include <Viewer/RIDS/Source.hh>
+#include <Viewer/RIDS/Type.hh>
+#include <Viewer/RIDS/Track.hh>
+#include <Viewer/RIDS/Vertex.hh>
+
+const int kMaxSources = 4; // Sources defined by the root file loader
+const int kMaxTypes = 4; // Types per source defined by the root file loader
+const double kDetectorRadius = 6000.0; // Vertices are generated within this radius, mm
+const double kStepLength = 100.0; // Track step length, mm
+const double kNominalRate = 1000.0; // Event time spacing if unthrottled, Hz
+
+EventGenerator::EventGenerator( const Settings& settings )
+  : fSettings( settings ), fClock( 0 ), fEventID( 0 )
+{
+  fSettings.fSources = max( 1, min( fSettings.fSources, kMaxSources ) );
+  fSettings.fTypes = max( 1, min( fSettings.fTypes, kMaxTypes ) );
+  fSettings.fChannels = max( 1, fSettings.fChannels );
+  fChannelIDs.resize( fSettings.fChannels );
+  for( int iChannel = 0; iChannel < fSettings.fChannels; iChannel++ )
+    fChannelIDs[iChannel] = iChannel;
+  // The state must not be zero
+  fState = ( static_cast<unsigned long long>( fSettings.fSeed ) + 1ULL ) * 0x9E3779B97F4A7C15ULL;
+}
+
+void
+EventGenerator::InitialiseRIDS() const
+{
+  const char* sourceNames[kMaxSources] = { "MC", "Truth", "UnCal", "Cal" };
+  const char* typeNames[kMaxTypes] = { "TAC", "QHL", "QHS", "QLX" };
+  RIDS::DataNames dataNames;
+  for( int iSource = 0; iSource < fSettings.fSources; iSource++ )
+    {
+      vector<string> types;
+      if( iSource == 0 )
+        {
+          // The MC source has hit times and photoelectron counts only
+          types.push_back( "TAC" );
+          if( fSettings.fTypes > 1 )
+            types.push_back( "PE" );
+        }
+      else
+        {
+          for( int iType = 0; iType < fSettings.fTypes; iType++ )
+            types.push_back( typeNames[iType] );
+        }
+      dataNames.push_back( pair< string, vector< string > >( sourceNames[iSource], types ) );
+    }
+  RIDS::Event::Initialise( dataNames );
+}
+
+RIDS::Event*
+EventGenerator::Generate()
+{
+  RIDS::Event* event = new RIDS::Event();
+  event->SetRunID( fSettings.fRunID );
+  event->SetSubRunID( 0 );
+  event->SetEventID( fEventID++ );
+  event->SetTrigger( static_cast<int>( Uniform() * 0x8000 ) );
+  event->SetTime( RIDS::Time( fClock ) );
+  // Times always advance, as with real data
+  fClock += static_cast<unsigned long long>( 1.0e7 / ( fSettings.fRate > 0.0 ? fSettings.fRate : kNominalRate ) );
+
+  // Choose distinct hit channels, a partial shuffle of the channel IDs
+  const int nhit = DrawNhit();
+  for( int iHit = 0; iHit < nhit; iHit++ )
+    swap( fChannelIDs[iHit], fChannelIDs[iHit + static_cast<int>( Uniform() * ( fSettings.fChannels - iHit ) )] );
+  // Each source sees the same hits, with a time and then charges
+  for( int iSource = 0; iSource < fSettings.fSources; iSource++ )
+    {
+      const size_t types = RIDS::Event::GetTypeNames( iSource ).size();
+      RIDS::Source source( types );
+      for( size_t iType = 0; iType < types; iType++ )
+        {
+          RIDS::Type type;
+          for( int iHit = 0; iHit < nhit; iHit++ )
+            {
+              double value;
+              if( iType == 0 )
+                value = max( 0.0, 250.0 + 20.0 * Normal() ); // Hit time, ns
+              else if( iSource == 0 )
+                value = 1.0 + floor( -log( 1.0 - Uniform() ) ); // Photoelectrons
+              else
+                value = floor( Uniform() * 4096.0 ); // ADC counts
+              type.AddChannel( fChannelIDs[iHit], value );
+            }
+          source.SetType( iType, type );
+        }
+      event->SetSource( iSource, source );
+    }
+
+  // Tracks start at a random vertex and wander outwards
+  const double radius = kDetectorRadius * pow( Uniform(), 1.0 / 3.0 );
+  const double cosTheta = 2.0 * Uniform() - 1.0;
+  const double phi = 2.0 * M_PI * Uniform();
+  const double sinTheta = sqrt( 1.0 - cosTheta * cosTheta );
+  const sf::Vector3<double> position( radius * sinTheta * cos( phi ), radius * sinTheta * sin( phi ), radius * cosTheta );
+  RIDS::Vertex vertex;
+  vertex.SetName( "Synthetic" );
+  vertex.SetPosition( position );
+  vertex.SetError( sf::Vector3<double>( 0.0, 0.0, 0.0 ) );
+  vertex.SetTime( 0.0 );
+  event->AddVertex( vertex );
+  vector<RIDS::Track> tracks;
+  for( int iTrack = 0; iTrack < fSettings.fTracks; iTrack++ )
+    {
+      vector<RIDS::TrackStep> steps;
+      TVector3 step( position.x, position.y, position.z );
+      TVector3 direction( Normal(), Normal(), Normal() );
+      for( int iStep = 0; iStep < fSettings.fTrackSteps; iStep++ )
+        {
+          direction += TVector3( Normal(), Normal(), Normal() ) * 0.2;
+          direction.SetMag( kStepLength );
+          step += direction;
+          steps.push_back( RIDS::TrackStep( step, kStepLength ) );
+        }
+      tracks.push_back( RIDS::Track( iTrack % 2 == 0 ? "e-" : "gamma", steps ) );
+    }
+  event->SetTracks( tracks );
+  return event;
+}
+
+double
+EventGenerator::Uniform()
+{
+  // xorshift64*, fast and good enough for synthetic data
+  fState ^= fState >> 12;
+  fState ^= fState << 25;
+  fState ^= fState >> 27;
+  return static_cast<double>( ( fState * 2685821657736338717ULL ) >> 11 ) / 9007199254740992.0;
+}
+
+double
+EventGenerator::Normal()
+{
+  // Box-Muller, 1 - Uniform is never zero
+  return sqrt( -2.0 * log( 1.0 - Uniform() ) ) * cos( 2.0 * M_PI * Uniform() );
+}
+
+int
+EventGenerator::DrawNhit()
+{
+  const double mean = fSettings.fMeanNhit;
+  double nhit = mean;
+  switch( fSettings.fDistribution )
+    {
+    case eFixed:
+      break;
+    case eUniform:
+      nhit = floor( Uniform() * ( 2.0 * mean + 1.0 ) );
+      break;
+    case ePoisson:
+      if( mean < 30.0 )
+        {
+          // Knuth's method, exact for small means
+          const double limit = exp( -mean );
+          double product = Uniform();
+          nhit = 0.0;
+          while( product > limit )
+            {
+              product *= Uniform();
+              nhit += 1.0;
+            }
+        }
+      else
+        nhit = floor( mean + sqrt( mean ) * Normal() + 0.5 );
+      break;
+    case eExponential:
+      nhit = floor( -mean * log( 1.0 - Uniform() ) );
+      break;
+    }
+  return static_cast<int>( max( 0.0, min( nhit, static_cast<double>( fSettings.fChannels ) ) ) );
+}
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::EventGenerator
+///
+/// \brief   Generates synthetic RIDS events
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Builds RIDS events without RAT or a data file, for the
+///          benchmarks. The nhit is drawn from the chosen distribution,
+///          the hit channels are distinct and every hit has a value per
+///          type. The sources and types mirror the root file loader,
+///          limited to the chosen counts. Events are spaced in (detector)
+///          time at the chosen rate. The generator is seeded, so the same
+///          settings always generate the same events.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_EventGenerator__
+#define __Viewer_EventGenerator__
+
+#include <vector>
+
+namespace Viewer
+{
+namespace RIDS
+{
+  class Event;
+}
+
+class EventGenerator
+{
+public:
+  /// The nhit distributions
+  enum ENhitDistribution { eFixed, eUniform, ePoisson, eExponential };
+  struct Settings
+  {
+    inline Settings();
+
+    ENhitDistribution fDistribution; /// < Nhit distribution
+    double fMeanNhit; /// < Mean nhit
+    int fChannels; /// < Number of channels hits are drawn from
+    int fSources; /// < Number of data sources filled, at most 4
+    int fTypes; /// < Number of types per source, at most 4
+    int fTracks; /// < Tracks per event
+    int fTrackSteps; /// < Steps per track
+    double fRate; /// < Event rate in Hz, zero or less is unthrottled
+    int fRunID; /// < Run ID of the events
+    unsigned int fSeed; /// < Random seed
+  };
+
+  EventGenerator( const Settings& settings );
+
+  /// Define the RIDS sources and types, call once before any events are generated
+  void InitialiseRIDS() const;
+  /// Return a new event, the caller owns it
+  RIDS::Event* Generate();
+  /// Return the settings
+  const Settings& GetSettings() const { return fSettings; }
+private:
+  /// Return a uniform random number in [0, 1)
+  double Uniform();
+  /// Return a standard normal random number
+  double Normal();
+  /// Return an nhit drawn from the distribution, limited to the channel count
+  int DrawNhit();
+
+  Settings fSettings; /// < The generation settings
+  std::vector<int> fChannelIDs; /// < Channel IDs, partially shuffled per event
+  unsigned long long fState; /// < Random number generator state
+  unsigned long long fClock; /// < 10MHz clock count of the next event
+  int fEventID; /// < ID of the next event
+};
+
+inline
+EventGenerator::Settings::Settings()
+  : fDistribution( ePoisson ), fMeanNhit( 1000.0 ), fChannels( 9728 ), fSources( 4 ), fTypes( 4 ),
+    fTracks( 0 ), fTrackSteps( 20 ), fRate( 100.0 ), fRunID( 0 ), fSeed( 1 )
+{
+
+}
+
+} //::Viewer
+
+#endif
@@ -4,6 +4,7 @@
 using namespace std;
 
 #include <Viewer/EventSelectionScript.hh>
+#include <Viewer/Profiler.hh>
 using namespace Viewer;
 #include <Viewer/RIDS/Event.hh>
 
@@ -51,6 +52,7 @@ EventSelectionScript::Load( const string& scriptName )
 bool
 EventSelectionScript::ProcessEvent( const RIDS::Event& event )
 {
+  Profiler::Scope scope( "EventSelectionScript::ProcessEvent" );
   /// Build data to send to the script
   PyObject* pDataDict = PyDict_New();
   PyObject* pTrigger = PyInt_FromLong( event.GetTrigger() );
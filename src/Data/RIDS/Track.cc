@@ -11,6 +11,12 @@ Track::Track( RAT::DS::MCTrack& rMCTrack )
         fTrackSteps.push_back( TrackStep( *rMCTrack.GetMCTrackStep( i ) ) );
 }
 
+Track::Track( const std::string& particleName, const std::vector< TrackStep >& trackSteps )
+    : fParticleName( particleName ), fTrackSteps( trackSteps )
+{
+
+}
+
 Track::~Track()
 {
 
@@ -35,6 +35,8 @@ class Track {
 
 public:
     Track( RAT::DS::MCTrack& rMCTrack );
+    /// Construct from the particle name and steps, e.g. for synthetic events
+    Track( const std::string& particleName, const std::vector< TrackStep >& trackSteps );
     ~Track();
     const std::string& GetParticleName() const;
     const std::vector< TrackStep >& GetTrackSteps() const;
@@ -10,6 +10,12 @@ TrackStep::TrackStep( RAT::DS::MCTrackStep& rMCTrackStep )
     fEndPos = rMCTrackStep.GetEndPos();
 }
 
+TrackStep::TrackStep( const TVector3& endPos, float length )
+    : fLength( length ), fEndPos( endPos )
+{
+
+}
+
 TrackStep::~TrackStep()
 {
 
@@ -32,6 +32,8 @@ class TrackStep {
 
 public:
     TrackStep( RAT::DS::MCTrackStep& rMCTrackStep );
+    /// Construct from the end position and length, e.g. for synthetic events
+    TrackStep( const TVector3& endPos, float length );
     ~TrackStep();
     const TVector3& GetEndPos() const;
 
@@ -1,3 +1,4 @@
+#include <vector>
 using namespace std;
 
 #include <Viewer/RenderState.hh>
@@ -12,6 +13,7 @@ RenderState::ChangeState( int source,
   fCurrentDataSource = source;
   fCurrentDataType = type;
   fChanged = true;
+  fStateChanged = true;
 }
 
 void 
@@ -20,6 +22,9 @@ RenderState::ChangeScaling( const double min,
 {
   fCurrentScalingMin = min;
   fCurrentScalingMax = max;
+  fLUTScale = 0.0;
+  if( max > min )
+    fLUTScale = static_cast<double>( ColourPalette::kLUTSize - 1 ) / ( max - min );
   fChanged = true;
 }
 
@@ -31,3 +36,29 @@ RenderState::GetDataColour( double data ) const
   else
     return GUIProperties::GetInstance().GetColourPalette().GetColour( ( data - fCurrentScalingMin ) / ( fCurrentScalingMax - fCurrentScalingMin ) );
 }
+
+sf::Uint32
+RenderState::GetPackedDataColour( double data ) const
+{
+  if( data < fCurrentScalingMin || data > fCurrentScalingMax )
+    return GUIProperties::GetInstance().GetGUIColourPalette().GetBackground().GetPacked();
+  else
+    return GUIProperties::GetInstance().GetColourPalette().GetLUT()[static_cast<int>( ( data - fCurrentScalingMin ) * fLUTScale + 0.5 )];
+}
+
+void
+RenderState::MapColours( const vector<double>& values,
+                         vector<sf::Uint32>& colours ) const
+{
+  colours.resize( values.size() );
+  const sf::Uint32 background = GUIProperties::GetInstance().GetGUIColourPalette().GetBackground().GetPacked();
+  const sf::Uint32* lut = &GUIProperties::GetInstance().GetColourPalette().GetLUT()[0];
+  for( size_t iValue = 0; iValue < values.size(); iValue++ )
+    {
+      const double data = values[iValue];
+      if( data < fCurrentScalingMin || data > fCurrentScalingMax )
+        colours[iValue] = background;
+      else
+        colours[iValue] = lut[static_cast<int>( ( data - fCurrentScalingMin ) * fLUTScale + 0.5 )];
+    }
+}
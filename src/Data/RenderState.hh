@@ -17,6 +17,10 @@
 #ifndef __Viewer_RenderState__
 #define __Viewer_RenderState__
 
+#include <SFML/Config.hpp>
+
+#include <vector>
+
 namespace Viewer
 {
 class Colour;
@@ -41,8 +45,16 @@ public:
   inline double GetScalingMin() const;
   inline double GetScalingMax() const;
   Colour GetDataColour( double data ) const;
+  /// Return the packed colour for the data, from the palette lookup table
+  sf::Uint32 GetPackedDataColour( double data ) const;
+  /// Map the data values to packed colours, from the palette lookup table
+  void MapColours( const std::vector<double>& values,
+                   std::vector<sf::Uint32>& colours ) const;
 
+  /// Return true if the data source, type or scaling has changed
   inline bool HasChanged() const;
+  /// Return true if the data source or type has changed, i.e. only a scaling change if HasChanged
+  inline bool HasStateChanged() const;
   inline void Reset();
 
 private:
@@ -51,13 +63,16 @@ private:
 
   double fCurrentScalingMin; /// < Lower numerical value to be displayed
   double fCurrentScalingMax; /// < Upper numerical value to be displayed
-  bool fChanged; /// < Mark if data source/type has changed in the last frame
+  double fLUTScale; /// < Conversion from data above the minimum to a lookup table index
+  bool fChanged; /// < Mark if data source/type or scaling has changed in the last frame
+  bool fStateChanged; /// < Mark if data source/type has changed in the last frame
 };
 
 inline 
 RenderState::RenderState()
 {
   ChangeState( 0, 0 );
+  ChangeScaling( 0.0, 0.0 );
 }
 
 inline 
@@ -65,6 +80,7 @@ RenderState::RenderState( int source,
                           int type )
 {
   ChangeState( source, type );
+  ChangeScaling( 0.0, 0.0 );
 }
 
 inline int
@@ -97,10 +113,17 @@ RenderState::HasChanged() const
   return fChanged;
 }
 
+inline bool
+RenderState::HasStateChanged() const
+{
+  return fStateChanged;
+}
+
 inline void
 RenderState::Reset()
 {
   fChanged = false;
+  fStateChanged = false;
 }
 
 } //::Viewer
@@ -0,0 +1,63 @@
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/RollingCounter.hh>
+using namespace Viewer;
+
+RollingCounter::RollingCounter( int buckets,
+                                int stacks )
+  : fBuckets( buckets ), fStacks( stacks ), fAdded( 0 )
+{
+  Clear();
+}
+
+void
+RollingCounter::Clear()
+{
+  fCounts.assign( fBuckets * fStacks, 0.0 );
+  fHead = 0;
+  fStarted = false;
+}
+
+void
+RollingCounter::Add( const RIDS::Time& time,
+                     int stack,
+                     double value )
+{
+  const int age = Advance( time );
+  if( age < 0 )
+    return;
+  fCounts[( ( fHead - age + fBuckets ) % fBuckets ) * fStacks + stack] += value;
+  fAdded++;
+}
+
+int
+RollingCounter::Advance( const RIDS::Time& time )
+{
+  if( !fStarted )
+    {
+      fStarted = true;
+      fHeadTime = time;
+      return 0;
+    }
+  const int elapsed = time - fHeadTime;
+  if( elapsed < 1 )
+    {
+      if( -elapsed >= fBuckets ) // Time has gone well backwards, e.g. new file, start again
+        {
+          Clear();
+          return Advance( time );
+        }
+      return -elapsed; // Late (or current) event, add to its bucket
+    }
+  // Shift the head forward, zeroing the buckets it moves into
+  const int shift = min( elapsed, fBuckets );
+  for( int iShift = 0; iShift < shift; iShift++ )
+    {
+      fHead = ( fHead + 1 ) % fBuckets;
+      fill( fCounts.begin() + fHead * fStacks, fCounts.begin() + ( fHead + 1 ) * fStacks, 0.0 );
+    }
+  fHeadTime = time;
+  return 0;
+}
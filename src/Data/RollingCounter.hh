@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::RollingCounter
+///
+/// \brief   Rolling per second, stacked counts
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  A ring of one second buckets, each holding a value per stack.
+///          Values are added at an event time, as time advances the
+///          oldest buckets are zeroed and reused, so each second costs a
+///          single bucket clear regardless of the number of buckets.
+///          Bucket age 0 holds the latest second.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_RollingCounter__
+#define __Viewer_RollingCounter__
+
+#include <vector>
+
+#include <Viewer/RIDS/Time.hh>
+
+namespace Viewer
+{
+
+class RollingCounter
+{
+public:
+  RollingCounter( int buckets,
+                  int stacks );
+
+  /// Add the value to the stack at the time
+  void Add( const RIDS::Time& time,
+            int stack,
+            double value = 1.0 );
+  /// Zero all the buckets
+  void Clear();
+
+  /// Return the value for the stack in the bucket age seconds before the latest
+  double Get( int age,
+              int stack ) const { return fCounts[( ( fHead - age + fBuckets ) % fBuckets ) * fStacks + stack]; }
+  int GetBuckets() const { return fBuckets; }
+  int GetStacks() const { return fStacks; }
+  /// Return the number of values added, changes when the counts change
+  int GetAdded() const { return fAdded; }
+private:
+  /// Advance the head to the time, returns the age of the bucket for the time or -1 if too old
+  int Advance( const RIDS::Time& time );
+
+  std::vector<double> fCounts; /// < The bucket values, bucket major
+  RIDS::Time fHeadTime; /// < Time the head bucket started
+  int fBuckets; /// < Number of buckets
+  int fStacks; /// < Number of stacks per bucket
+  int fHead; /// < Index of the latest bucket
+  int fAdded; /// < Number of values added
+  bool fStarted; /// < True once a time has been added
+};
+
+} //::Viewer
+
+#endif
@@ -0,0 +1,22 @@
+#include <Viewer/StreamSummary.hh>
+using namespace Viewer;
+#include <Viewer/RIDS/Event.hh>
+
+void
+StreamSummary::AddEvent( const RIDS::Event& event )
+{
+  const RIDS::Time& time = event.GetTime();
+  const int trigger = event.GetTrigger();
+  if( trigger == 0x0 )
+    fTriggers.Add( time, eNone );
+  if( trigger & 0x01 || trigger & 0x02 || trigger & 0x04 )
+    fTriggers.Add( time, eNHit100 );
+  if( trigger & 0x08 || trigger & 0x10 )
+    fTriggers.Add( time, eNHit20 );
+  if( trigger & 0x20 || trigger & 0x40 )
+    fTriggers.Add( time, eESum );
+  if( trigger & 0x80 || trigger & 0x100 || trigger & 0x200 )
+    fTriggers.Add( time, eOWL );
+  if( trigger & 0x400 || trigger & 0x800 || trigger & 0x1000 || trigger & 0x2000 || trigger & 0x4000 || trigger & 0x8000 )
+    fTriggers.Add( time, eOther );
+}
@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::StreamSummary
+///
+/// \brief   Rolling per second counts of the ingested events
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  The DataStore adds every event to this summary as it is
+///          ingested, the stream frames only read the counters. Further
+///          counters (e.g. nhit or per source rates) are a RollingCounter
+///          and a line in AddEvent.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_StreamSummary__
+#define __Viewer_StreamSummary__
+
+#include <Viewer/RollingCounter.hh>
+
+namespace Viewer
+{
+namespace RIDS
+{
+  class Event;
+}
+
+class StreamSummary
+{
+public:
+  static const int kSeconds = 200;
+  /// Trigger stacks, each is a group of trigger bits
+  enum ETrigger { eNone, eNHit100, eNHit20, eESum, eOWL, eOther, eTriggerCount };
+
+  StreamSummary() : fTriggers( kSeconds, eTriggerCount ) { }
+  /// Add an event to the counters
+  void AddEvent( const RIDS::Event& event );
+
+  /// Return the per second trigger counts, stacked by ETrigger
+  const RollingCounter& GetTriggers() const { return fTriggers; }
+private:
+  RollingCounter fTriggers; /// < Trigger counts
+};
+
+} //::Viewer
+
+#endif
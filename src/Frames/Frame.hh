@@ -10,7 +10,12 @@
 ///     06/04/13 : P.Jones - Refactor into 2d and 3d versions. \n
 ///
 /// \detail  All frames derive from this base class. The base class deals
-///          with the GUIManager.
+///          with the GUIManager. Event processing is split in two, the
+///          CPU work in PrepareEvent and then the image/buffer updates in
+///          ProcessEvent. If a frame declares PrepareEvent thread safe
+///          (it must only read the DataSelector, DataStore and RenderState
+///          and its own members, no GL or GUI) the FrameManager runs it on
+///          the Scheduler alongside the other frames.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -46,8 +51,14 @@ public:
   virtual void PreInitialise( const ConfigurationTable* configTable ) = 0;
   /// Initilaise with DataStore access
   virtual void PostInitialise( const ConfigurationTable* configTable ) = 0;
-  /// Process event data
+  /// Prepare the event data on the CPU, called before ProcessEvent
+  virtual void PrepareEvent( const RenderState& renderState ) { }
+  /// Return true if PrepareEvent is thread safe and may run concurrently with other frames
+  virtual bool IsPrepareThreadSafe() const { return false; }
+  /// Process event data, after PrepareEvent
   virtual void ProcessEvent( const RenderState& renderState ) = 0;
+  /// Process a scaling or colour change only, by default reprocess the event
+  virtual void ProcessScaling( const RenderState& renderState ) { PrepareEvent( renderState ); ProcessEvent( renderState ); }
   /// Process run data
   virtual void ProcessRun() = 0;
   /// Render all 2d objects
@@ -1,4 +1,5 @@
 #include <SFML/Window/Event.hpp>
+#include <SFML/System/Clock.hpp>
 
 #include <Viewer/FrameContainer.hh>
 #include <Viewer/TopBar.hh>
@@ -7,10 +8,11 @@
 #include <Viewer/Event.hh>
 #include <Viewer/ConfigurationTable.hh>
 #include <Viewer/Button.hh>
+#include <Viewer/Profiler.hh>
 using namespace Viewer;
 
 FrameContainer::FrameContainer( RectPtr rect )
-  : fRect( rect )
+  : fRect( rect ), fPrepareTime( 0.0 )
 {
 
 }
@@ -108,15 +110,39 @@ FrameContainer::SaveConfiguration( ConfigurationTable* configTable )
   fFrame->SaveConfiguration( configTable );
 }
 
+void
+FrameContainer::PrepareEvent( const RenderState& renderState )
+{
+  Profiler::Scope scope( fScopeNames[ePrepareEvent] );
+  sf::Clock clock;
+  fFrame->PrepareEvent( renderState );
+  fPrepareTime = clock.getElapsedTime().asSeconds();
+}
+
+bool
+FrameContainer::IsPrepareThreadSafe() const
+{
+  return fFrame->IsPrepareThreadSafe();
+}
+
 void
 FrameContainer::ProcessEvent( const RenderState& renderState )
 {
+  Profiler::Scope scope( fScopeNames[eProcessEvent] );
   fFrame->ProcessEvent( renderState );
 }
 
+void
+FrameContainer::ProcessScaling( const RenderState& renderState )
+{
+  Profiler::Scope scope( fScopeNames[eProcessScaling] );
+  fFrame->ProcessScaling( renderState );
+}
+
 void
 FrameContainer::ProcessRun()
 {
+  Profiler::Scope scope( fScopeNames[eProcessRun] );
   fFrame->ProcessRun();
 }
 
@@ -124,6 +150,7 @@ void
 FrameContainer::Render2d( RWWrapper& renderApp, 
                           const RenderState& renderState )
 {
+  Profiler::Scope scope( fScopeNames[eRender2d] );
   fFrame->Render2d( renderApp, renderState );
 }
 
@@ -131,6 +158,7 @@ void
 FrameContainer::Render3d( RWWrapper& renderApp, 
                           const RenderState& renderState )
 {
+  Profiler::Scope scope( fScopeNames[eRender3d] );
   fFrame->Render3d( renderApp, renderState );
 }
 
@@ -171,6 +199,15 @@ FrameContainer::SetRect( const sf::Rect<double>& rect,
   fResizeButton->GetRect()->SetRect( resizeSize, Rect::eResolution );
 }
 
+void
+FrameContainer::SetFrame( Frame* frame )
+{
+  fFrame = frame;
+  const char* stages[eStageCount] = { "::PrepareEvent", "::ProcessEvent", "::ProcessScaling", "::ProcessRun", "::Render2d", "::Render3d" };
+  for( int iStage = 0; iStage < eStageCount; iStage++ )
+    fScopeNames[iStage] = Profiler::GetInstance().Intern( fFrame->GetName() + stages[iStage] );
+}
+
 bool
 FrameContainer::IsPinned()
 {
@@ -57,8 +57,16 @@ public:
   void PreInitialise( const ConfigurationTable* configTable );
   /// Initilaise with DataStore access
   void PostInitialise( const ConfigurationTable* configTable );
+  /// Prepare the event data on the CPU, timed
+  void PrepareEvent( const RenderState& renderState );
+  /// Return true if the frame's PrepareEvent is thread safe
+  bool IsPrepareThreadSafe() const;
+  /// Return the time in seconds the last PrepareEvent took
+  double GetPrepareTime() const { return fPrepareTime; }
   /// Process event data
   void ProcessEvent( const RenderState& renderState );
+  /// Process a scaling or colour change only
+  void ProcessScaling( const RenderState& renderState );
   /// Process run data
   void ProcessRun();
   /// Render all 2d objects
@@ -83,13 +91,19 @@ public:
 		const Rect::ECoordSystem& system );
 
   bool IsPinned();
-  void SetFrame( Frame* frame ) { fFrame = frame; }
+  /// Set the frame, interns its profiler scope names
+  void SetFrame( Frame* frame );
 private:
+  /// The profiled stages, indexes fScopeNames
+  enum EStage { ePrepareEvent, eProcessEvent, eProcessScaling, eProcessRun, eRender2d, eRender3d, eStageCount };
+
   RectPtr fRect; /// < The container rect
   Frame* fFrame; /// < The frame
   TopBar* fTopBar; /// < The top bar GUI
   FrameOutline* fFrameOutline; /// < The outline gui
   GUIs::Button* fResizeButton; /// < The resize button (bottom right)
+  double fPrepareTime; /// < Seconds the last PrepareEvent took
+  const char* fScopeNames[eStageCount]; /// < Interned profiler scope name per stage
 };
 
 inline bool
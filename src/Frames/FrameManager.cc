@@ -12,8 +12,25 @@ using namespace std;
 #include <Viewer/ConfigurationTable.hh>
 #include <Viewer/GUIProperties.hh>
 #include <Viewer/Panel.hh>
+#include <Viewer/Scheduler.hh>
+#include <Viewer/Profiler.hh>
 using namespace Viewer;
 
+namespace
+{
+/// Runs a frame container's thread safe PrepareEvent on the Scheduler
+class PrepareTask : public Scheduler::Task
+{
+public:
+  PrepareTask( FrameContainer& frameContainer,
+               const RenderState& renderState ) : Scheduler::Task( "PrepareEvent" ), fFrameContainer( &frameContainer ), fRenderState( &renderState ) { }
+  virtual void Execute() { fFrameContainer->PrepareEvent( *fRenderState ); }
+private:
+  FrameContainer* fFrameContainer; /// < The container to prepare
+  const RenderState* fRenderState; /// < The render state to prepare with
+};
+}
+
 FrameManager::FrameManager( RectPtr rect )
   : fRect( rect )
 {
@@ -181,10 +198,43 @@ FrameManager::SaveConfiguration( ConfigurationTable* configTable )
 void
 FrameManager::ProcessEvent( const RenderState& renderState )
 {
+  // Prepare (CPU only) in parallel where the frames allow it, then process (upload) on this thread
+  Profiler& profiler = Profiler::GetInstance();
+  const double start = profiler.Now();
+  vector<PrepareTask> prepareTasks;
+  prepareTasks.reserve( fFrameContainers.size() );
+  for( vector<FrameContainer*>::iterator iTer = fFrameContainers.begin(); iTer != fFrameContainers.end(); iTer++ )
+    {
+      if( (*iTer)->IsPrepareThreadSafe() )
+        prepareTasks.push_back( PrepareTask( **iTer, renderState ) );
+      else
+        (*iTer)->PrepareEvent( renderState );
+    }
+  // Submit once all are added, the tasks must not move once submitted; this thread helps whilst waiting
+  Scheduler& scheduler = Scheduler::GetInstance();
+  for( vector<PrepareTask>::iterator iTer = prepareTasks.begin(); iTer != prepareTasks.end(); iTer++ )
+    scheduler.Submit( *iTer );
+  for( vector<PrepareTask>::iterator iTer = prepareTasks.begin(); iTer != prepareTasks.end(); iTer++ )
+    scheduler.Wait( *iTer );
+  const double end = profiler.Now();
+  profiler.Record( "FrameManager::Prepare", start, end );
+  // The summed frame prepare times over the phase time, i.e. the parallel speedup
+  double summedTime = 0.0;
+  for( vector<FrameContainer*>::const_iterator iTer = fFrameContainers.begin(); iTer != fFrameContainers.end(); iTer++ )
+    summedTime += (*iTer)->GetPrepareTime();
+  if( end > start )
+    profiler.SetCounter( "FrameManager::PrepareSpeedup", summedTime / ( end - start ) );
   for( vector<FrameContainer*>::iterator iTer = fFrameContainers.begin(); iTer != fFrameContainers.end(); iTer++ )
     (*iTer)->ProcessEvent( renderState );
 }
 
+void
+FrameManager::ProcessScaling( const RenderState& renderState )
+{
+  for( vector<FrameContainer*>::iterator iTer = fFrameContainers.begin(); iTer != fFrameContainers.end(); iTer++ )
+    (*iTer)->ProcessScaling( renderState );
+}
+
 void
 FrameManager::ProcessRun()
 {
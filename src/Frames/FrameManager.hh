@@ -10,7 +10,11 @@
 ///     26/05/12 : P.Jones - Second Revision, refactor no grid.\n
 ///
 /// \detail  This class manages the existance, position, creation and 
-///          destruction of all frames in a desktop.
+///          destruction of all frames in a desktop. The frames' thread
+///          safe PrepareEvent steps are run in parallel on the Scheduler,
+///          then all the frames ProcessEvent on the main thread. The
+///          prepare phase time and its parallel speedup are recorded by
+///          the Profiler.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -56,6 +60,8 @@ public:
   void PostInitialise( const ConfigurationTable* configTable );
   /// Process event data
   void ProcessEvent( const RenderState& renderState );
+  /// Process a scaling or colour change only
+  void ProcessScaling( const RenderState& renderState );
   /// Process run data
   void ProcessRun();
   /// Render all 2d objects
@@ -1,7 +1,15 @@
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include <SFML/Graphics/Rect.hpp>
+
 #include <Viewer/Histogram.hh>
 #include <Viewer/RenderState.hh>
 #include <Viewer/DataSelector.hh>
 #include <Viewer/GUIProperties.hh>
+#include <Viewer/PersistLabel.hh>
+#include <Viewer/ConfigurationTable.hh>
 using namespace Viewer;
 using namespace Viewer::Frames;
 #include <Viewer/RIDS/Event.hh>
@@ -10,13 +18,20 @@ void
 Histogram::PreInitialise( const ConfigurationTable* configTable )
 {
   HistogramBase::PreInitialise( configTable );
+  if( configTable != NULL && configTable->Has( "accumulate" ) )
+    fAccumulate = configTable->GetI( "accumulate" );
   Initialise();
+  const sf::Rect<double> accumulateSize( 0.8, 0.0, 0.2, 0.05 ); // Top right, clear of the axis labels
+  GUIs::PersistLabel* accumulate = fGUIManager.NewGUI<GUIs::PersistLabel>( accumulateSize, eAccumulate );
+  accumulate->Initialise( 16, "Sum shown" );
+  accumulate->SetState( fAccumulate );
 }
 
 void
 Histogram::SaveConfiguration( ConfigurationTable* configTable )
 {
   HistogramBase::SaveConfiguration( configTable );
+  configTable->SetI( "accumulate", fAccumulate );
 }
 
 void
@@ -26,8 +41,12 @@ Histogram::EventLoop()
     {
       switch( fEvents.front().fguiID )
         {
-        case 0: // Nothing to do with this class
-          GUIEvent( 0 );
+        case eMapArea: // Nothing to do with this class
+          GUIEvent( eMapArea );
+          break;
+        case eAccumulate:
+          // Accumulation of the displayed events starts from the current one, applied at the next ProcessEvent
+          fAccumulate = dynamic_cast<GUIs::PersistLabel*>( fGUIManager.GetGUI( eAccumulate ) )->GetState();
           break;
         }
       fEvents.pop();
@@ -35,40 +54,55 @@ Histogram::EventLoop()
 }
 
 void 
-Histogram::ProcessEvent( const RenderState& renderState )
+Histogram::PrepareEvent( const RenderState& renderState )
 {
-  // Initialise the stacks
-  fValues.clear();
   fXDomain = pair<double, double>( renderState.GetScalingMin(), renderState.GetScalingMax() );
-  if( fXDomain.second - fXDomain.first < GetMaxNumberOfBins() )
-    fValues.resize( static_cast<int>( fXDomain.second - fXDomain.first ) + 2, vector<double>( 1, 0.0 ) );
-  else
-    fValues.resize( GetMaxNumberOfBins(), vector<double>( 1, 0.0 ) );
-  // Now fill
-  const vector<RIDS::Channel>& hits = DataSelector::GetInstance().GetData( renderState.GetDataSource(), renderState.GetDataType() );
-  if( hits.empty() )
-    return;
-  for( vector<RIDS::Channel>::const_iterator iTer = hits.begin(); iTer != hits.end(); iTer++ )
-    {
-      int iBin = 0;
-      if( iTer->GetData() <= fXDomain.first )
-        iBin = 0;
-      else if( iTer->GetData() >= fXDomain.second )
-        iBin = fValues.size() - 1;
-      else
-        iBin = static_cast<int>( ( iTer->GetData() - fXDomain.first ) / ( fXDomain.second - fXDomain.first ) * ( fValues.size() - 2 ) ) + 1;
-      fValues[iBin][0] += iTer->GetData();
-    }
+  unsigned int bins = GetMaxNumberOfBins();
+  if( fXDomain.second - fXDomain.first < bins )
+    bins = static_cast<int>( fXDomain.second - fXDomain.first ) + 2;
+  const RIDS::Event& event = DataSelector::GetInstance().GetEvent();
+  const pair<int, int> eventID( event.GetRunID(), event.GetEventID() );
+  const pair<int, int> dataID( renderState.GetDataSource(), renderState.GetDataType() );
+  // The bins are only comparable if the binning and data are unchanged
+  const bool binningChanged = ResizeBins( bins, 1 ) || fXDomain != fFilledDomain || dataID != fFilledData;
+  if( !fAccumulate || binningChanged )
+    ClearBins();
+  // Don't add the same event twice when accumulating, e.g. if only the colours changed
+  if( !fAccumulate || binningChanged || eventID != fFilledEvent )
+    Fill( DataSelector::GetInstance().GetData( renderState.GetDataSource(), renderState.GetDataType() ) );
+  fFilledDomain = fXDomain;
+  fFilledData = dataID;
+  fFilledEvent = eventID;
   // Now find the Y domain
   double maxValue = 0.0;
-  for( unsigned int iBin = 0; iBin < fValues.size(); iBin++ )
+  for( unsigned int iBin = 0; iBin < fBins; iBin++ )
+    maxValue = max( GetBin( iBin, 0 ), maxValue );
+  fYRange = pair<double, double>( 0.0, maxValue );
+}
+
+void
+Histogram::Fill( const vector<RIDS::Channel>& hits )
+{
+  const size_t count = hits.size();
+  fData.resize( count );
+  fBinIndices.resize( count );
+  for( size_t iHit = 0; iHit < count; iHit++ )
+    fData[iHit] = hits[iHit].GetData();
+  // Bin index kernel, branch free (selects) over flat arrays so the compiler can vectorise it
+  const double low = fXDomain.first;
+  const double high = fXDomain.second;
+  const double scale = static_cast<double>( fBins - 2 ) / ( high - low );
+  const double lastBin = static_cast<double>( fBins - 1 );
+  for( size_t iHit = 0; iHit < count; iHit++ )
     {
-      double value = fValues[iBin][0];
-      maxValue = max( value, maxValue );
+      const double value = fData[iHit];
+      double bin = ( value - low ) * scale + 1.0;
+      bin = value <= low ? 0.0 : bin; // Underflow
+      bin = value >= high ? lastBin : bin; // Overflow
+      fBinIndices[iHit] = static_cast<unsigned int>( bin );
     }
-  fYRange = pair<double, double>( 0.0, maxValue );
-  // Now render to the image
-  RenderToImage();
+  for( size_t iHit = 0; iHit < count; iHit++ )
+    GetBin( fBinIndices[iHit], 0 ) += fData[iHit];
 }
 
 Colour 
@@ -8,13 +8,19 @@
 /// REVISION HISTORY:\n
 ///     16/05/12 : P.Jones - First Revision, new file (refactored version). \n
 ///
-/// \detail  Draws a histogram of the current selected data.
+/// \detail  Draws a histogram of the current selected data. In accumulate
+///          mode each displayed event is added to the histogram (events
+///          skipped by the selection are not), which is reset if the data
+///          type or scaling changes.
 ///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef __Viewer_Frames_Histogram__
 #define __Viewer_Frames_Histogram__
 
+#include <vector>
+#include <utility>
+
 #include <Viewer/HistogramBase.hh>
 
 namespace Viewer
@@ -22,6 +28,7 @@ namespace Viewer
 namespace RIDS
 {
   class Event;
+  class Channel;
 }
 
 namespace Frames
@@ -30,7 +37,7 @@ namespace Frames
 class Histogram : public HistogramBase
 {
 public:
-  Histogram( RectPtr rect ) : HistogramBase( rect ) { }
+  Histogram( RectPtr rect ) : HistogramBase( rect ), fAccumulate( false ) { }
   virtual ~Histogram() { };
 
   /// Initialise without using the DataStore
@@ -46,14 +53,24 @@ public:
 
   static std::string Name() { return std::string( "Histogram" ); }
 
-  virtual void ProcessEvent( const RenderState& renderState );
+  virtual void PrepareEvent( const RenderState& renderState );
 
   virtual void ProcessRun() { };
 protected:
+  enum EGUIs { eMapArea, eAccumulate };
   /// Return the render colour given the stack, bin and value
   Colour GetRenderColor( const unsigned int stack,
                          const unsigned int bin,
                          const double value );
+  /// Add the hit data to the bins
+  void Fill( const std::vector<RIDS::Channel>& hits );
+
+  std::vector<double> fData; /// < Hit data values, reused scratch space
+  std::vector<unsigned int> fBinIndices; /// < Bin index per hit, reused scratch space
+  std::pair<double, double> fFilledDomain; /// < X domain the bins were filled with
+  std::pair<int, int> fFilledData; /// < Data source and type the bins were filled with
+  std::pair<int, int> fFilledEvent; /// < Run and event ID last filled
+  bool fAccumulate; /// < Add each event to the histogram rather than replacing it
 };
 
 } // ::Frames
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <vector>
+using namespace std;
+
 #include <Viewer/HistogramBase.hh>
 #include <Viewer/ProjectionImage.hh>
 #include <Viewer/RWWrapper.hh>
@@ -33,19 +37,19 @@ HistogramBase::Render2d( RWWrapper& windowApp,
                          const RenderState& renderState )
 {
   windowApp.Draw( *fImage );
-  for( vector<Text>::iterator iTer = fAxisText.begin(); iTer != fAxisText.end(); iTer++ )
+  for( unsigned int iText = 0; iText < fNumAxisText; iText++ )
     {
-      iTer->SetColour( GUIProperties::GetInstance().GetGUIColourPalette().GetText() );
-      windowApp.Draw( *iTer );
+      fAxisText[iText].SetColour( GUIProperties::GetInstance().GetGUIColourPalette().GetText() );
+      windowApp.Draw( fAxisText[iText] );
     }
-  if( fMousePos.x > 0.0 && fMousePos.x < 1.0 )
+  if( fMousePos.x > 0.0 && fMousePos.x < 1.0 && fBins > 0 )
     {
-      const int bin = static_cast<int>( fMousePos.x * fValues.size() );
+      const int bin = static_cast<int>( fMousePos.x * fBins );
       stringstream info;
       info << "(" << bin;
       info << ", " << fMousePos.x * ( fXDomain.second - fXDomain.first ) + fXDomain.first;
-      for( unsigned int iStack = 0; iStack < fValues[bin].size(); iStack++ )
-        info << ", " << fValues[bin][iStack];
+      for( unsigned int iStack = 0; iStack < fStacks; iStack++ )
+        info << ", " << GetBin( bin, iStack );
       info << ")";
       fInfoText->SetString( info.str() );
       fInfoText->SetColour( GUIProperties::GetInstance().GetGUIColourPalette().GetText() );
@@ -77,20 +81,38 @@ HistogramBase::GUIEvent( unsigned int guiID )
     fMousePos = dynamic_cast<GUIs::MapArea*>( fGUIManager.GetGUI( 0 ) )->GetPosition();
 }
 
+bool
+HistogramBase::ResizeBins( unsigned int bins,
+                           unsigned int stacks )
+{
+  if( bins == fBins && stacks == fStacks )
+    return false;
+  fBins = bins;
+  fStacks = stacks;
+  fValues.assign( fBins * fStacks, 0.0 ); // Keeps the capacity if shrinking
+  return true;
+}
+
+void
+HistogramBase::ClearBins()
+{
+  fill( fValues.begin(), fValues.end(), 0.0 );
+}
+
 void
 HistogramBase::RenderToImage()
 {
-  fAxisText.clear();
+  fNumAxisText = 0;
   fImage->Clear();
   // First the histogram drawing part
   if( !fValues.empty() && fYRange.second > 0.0 ) 
     {
-      const double binWidth = 1.0 / static_cast<double>( fValues.size() );
-      for( unsigned int iBin = 0; iBin < fValues.size(); iBin++ )
+      const double binWidth = 1.0 / static_cast<double>( fBins );
+      for( unsigned int iBin = 0; iBin < fBins; iBin++ )
         {
-          const vector<double> values = fValues[iBin];
+          const double* values = &fValues[iBin * fStacks];
           double valueOffset = 0.0; // Sum of the previous stack values
-          for( unsigned int iStack = 0; iStack < values.size(); iStack++ )
+          for( unsigned int iStack = 0; iStack < fStacks; iStack++ )
             {
               const double value = values[iStack] + valueOffset;
               if( value > 0.0 )
@@ -149,7 +171,10 @@ HistogramBase::DrawTickLabel( double value,
       textSize = sf::Rect<double>( kAxisMargin / 6.0, pos.y - kAxisMargin / 2.0, kAxisMargin, kAxisMargin );
     }
   fImage->DrawSquare( pos, size, GUIProperties::GetInstance().GetGUIColourPalette().GetAspect() );
-  Text label( RectPtr( fRect->NewDaughter( textSize, Rect::eLocal ) ) );
+  if( fNumAxisText == fAxisText.size() )
+    fAxisText.push_back( Text( RectPtr( fRect->NewDaughter() ) ) );
+  Text& label = fAxisText[fNumAxisText++];
+  label.GetRect()->SetRect( textSize, Rect::eLocal );
   stringstream temp; 
   temp << value;
   if( value == 0.0 )
@@ -158,7 +183,6 @@ HistogramBase::DrawTickLabel( double value,
         temp << ' ';
     }
   label.SetString( temp.str() );
-  fAxisText.push_back( label );
 }
 
 double
@@ -8,7 +8,12 @@
 /// REVISION HISTORY:\n
 ///     29/06/12 : P.Jones - First Revision, new file. \n
 ///
-/// \detail  Draws histograms onto the screen. 
+/// \detail  Draws histograms onto the screen. The bin values are held in
+///          a single bin major array of bins x stacks, which is only
+///          reallocated if the number of bins or stacks changes. Derived
+///          classes fill the bins and set the domain and range in
+///          PrepareEvent, which must be thread safe. ProcessEvent then
+///          renders the bins to the image.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -31,7 +36,7 @@ namespace Frames
 class HistogramBase : public Frame2d
 {
 public:
-  HistogramBase( RectPtr rect ) : Frame2d( rect ), fLogY( false ) { }
+  HistogramBase( RectPtr rect ) : Frame2d( rect ), fBins( 0 ), fStacks( 0 ), fNumAxisText( 0 ), fLogY( false ) { }
   virtual ~HistogramBase();
 
   /// Initialise without using the DataStore
@@ -39,6 +44,11 @@ public:
   /// Save the configuration
   void SaveConfiguration( ConfigurationTable* configTable );
   
+  /// The bins are filled independently of other frames
+  virtual bool IsPrepareThreadSafe() const { return true; }
+  /// Render the prepared bins
+  virtual void ProcessEvent( const RenderState& renderState ) { RenderToImage(); }
+  
   virtual void Render2d( RWWrapper& renderApp, 
                          const RenderState& renderState );
 protected:
@@ -54,19 +64,32 @@ protected:
   void RenderToImage();
   /// Should be called by derived classes when they don't recognise the event
   void GUIEvent( unsigned int eventID );
+  /// Set the number of bins and stacks, returns true (and zeros the values) if changed
+  bool ResizeBins( unsigned int bins,
+                   unsigned int stacks );
+  /// Zero all the bin values
+  void ClearBins();
+  /// Return the value for the bin and stack
+  double& GetBin( unsigned int bin,
+                  unsigned int stack ) { return fValues[bin * fStacks + stack]; }
+  double GetBin( unsigned int bin,
+                 unsigned int stack ) const { return fValues[bin * fStacks + stack]; }
 
-  std::vector< std::vector<double> > fValues; /// < The stack of histogram bin values
+  std::vector<double> fValues; /// < The histogram bin values, bin major i.e. [bin * fStacks + stack]
+  unsigned int fBins; /// < Number of bins
+  unsigned int fStacks; /// < Number of stacks per bin
   std::pair<double, double> fXDomain; /// < Domain in x that corresponds to the bins, from low to high
   std::pair<double, double> fYRange; /// < Range in y to draw, from low to high
 private:
-  /// Draw a tick on the image and save a text
+  /// Draw a tick on the image and set the next axis label text
   void DrawTickLabel( double value,
                       int oridnal,
                       bool xAxis );
   /// Scale the value into a y relative coord
   double ScaleY( const double value ) const;
 
-  std::vector<Text> fAxisText; /// < The axis labels
+  std::vector<Text> fAxisText; /// < The axis labels, reused between events
+  unsigned int fNumAxisText; /// < Number of fAxisText in use
   sf::Vector2<double> fMousePos; /// < The mouse position (-1, -1) if not in frame
   Text* fInfoText; /// < Displays info about the selected bin
   ProjectionImage* fImage; /// < The actual image
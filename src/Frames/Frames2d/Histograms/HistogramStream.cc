@@ -1,59 +1,47 @@
+#include <algorithm>
+using namespace std;
+
 #include <Viewer/HistogramStream.hh>
+#include <Viewer/RollingCounter.hh>
 #include <Viewer/RenderState.hh>
-#include <Viewer/DataSelector.hh>
 #include <Viewer/GUIProperties.hh>
 using namespace Viewer;
 using namespace Viewer::Frames;
-#include <Viewer/RIDS/Event.hh>
 
 void 
-HistogramStream::SetNumBinsStacks( const int numBins,
-                                   const int numStacks )
+HistogramStream::Render2d( RWWrapper& renderApp,
+                           const RenderState& renderState )
 {
-  fNumBins = min( static_cast<int>( GetMaxNumberOfBins() ), numBins );
-  fNumStacks = numStacks;
+  if( GetCounter().GetAdded() != fAdded )
+    {
+      PrepareEvent( renderState );
+      ProcessEvent( renderState );
+    }
+  HistogramBase::Render2d( renderApp, renderState );
 }
 
 void 
-HistogramStream::ProcessEvent( const RenderState& renderState )
+HistogramStream::PrepareEvent( const RenderState& renderState )
 {
-  // Initialise the stacks
-  fValues.clear();
-  fValues.resize( fNumBins, vector<double>( fNumStacks, 0.0 ) );
-  // Now fill
-  fXDomain = pair<double, double>( 0.0, fNumBins );
-  if( fNumBins > GetMaxNumberOfBins() )
-    return; // Some issues here....
-  const RIDS::Event& event = DataSelector::GetInstance().GetEvent();
-  const RIDS::Time& eventTime = event.GetTime();
-  ExtractData( event, 0 );
-  double diffTime = 0.0;
-  int peek = -1;
-  while( true )
-    {
-      const RIDS::Event* peekEvent = DataSelector::GetInstance().PeekEvent( peek );
-      if( peekEvent == NULL )
-        break;
-      const RIDS::Time& peekTime = peekEvent->GetTime();
-      diffTime = eventTime - peekTime;
-      if( diffTime < 0.0 || diffTime > fNumBins )
-        break;
-      unsigned int iBin = static_cast<unsigned int>( diffTime );
-      ExtractData( *peekEvent, iBin );
-      peek--;
-    }
-  // Now find the Y domain
+  const RollingCounter& counter = GetCounter();
+  fAdded = counter.GetAdded();
+  // Copy the counts into the bins, reusing the storage
+  const unsigned int numBins = min( GetMaxNumberOfBins(), static_cast<unsigned int>( counter.GetBuckets() ) );
+  const unsigned int numStacks = counter.GetStacks();
+  ResizeBins( numBins, numStacks );
+  fXDomain = pair<double, double>( 0.0, numBins );
   double maxValue = 0.0;
-  for( unsigned int iBin = 0; iBin < fNumBins; iBin++ )
+  for( unsigned int iBin = 0; iBin < numBins; iBin++ )
     {
       double value = 0.0;
-      for( unsigned int iStack = 0; iStack < fNumStacks; iStack++ )
-        value += fValues[iBin][iStack];
+      for( unsigned int iStack = 0; iStack < numStacks; iStack++ )
+        {
+          GetBin( iBin, iStack ) = counter.Get( iBin, iStack );
+          value += GetBin( iBin, iStack );
+        }
       maxValue = max( value, maxValue );
     }
   fYRange = pair<double, double>( 0.0, maxValue );
-  // Now render to the image
-  RenderToImage();
 }
 
 Colour 
@@ -61,5 +49,5 @@ HistogramStream::GetRenderColor( const unsigned int stack,
                                  const unsigned int,
                                  const double )
 {
-  return GUIProperties::GetInstance().GetColourPalette().GetColour( static_cast<double>( stack ) / static_cast<double>( fNumStacks ) );
+  return GUIProperties::GetInstance().GetColourPalette().GetColour( static_cast<double>( stack ) / static_cast<double>( fStacks ) );
 }
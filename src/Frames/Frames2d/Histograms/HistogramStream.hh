@@ -8,7 +8,9 @@
 /// REVISION HISTORY:\n
 ///     13/05/12 : P.Jones - First Revision, new file. \n
 ///
-/// \detail  Draws the last fNumBins in seconds of data to the screen
+/// \detail  Draws the last seconds of ingested data to the screen, the
+///          counts are kept by a RollingCounter updated by the DataStore,
+///          this only copies them into the bins when they change.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -19,10 +21,7 @@
 
 namespace Viewer
 {
-namespace RIDS
-{
-  class Event;
-}
+  class RollingCounter;
 
 namespace Frames
 {
@@ -30,10 +29,13 @@ namespace Frames
 class HistogramStream : public HistogramBase
 {
 public:
-  HistogramStream( RectPtr rect ) : HistogramBase( rect ) { }
+  HistogramStream( RectPtr rect ) : HistogramBase( rect ), fAdded( -1 ) { }
   virtual ~HistogramStream() { };
 
-  virtual void ProcessEvent( const RenderState& renderState );
+  virtual void Render2d( RWWrapper& renderApp,
+                         const RenderState& renderState );
+
+  virtual void PrepareEvent( const RenderState& renderState );
 
   virtual void ProcessRun() { };
 protected:
@@ -41,15 +43,10 @@ protected:
   Colour GetRenderColor( const unsigned int stack,
 			 const unsigned int bin,
 			 const double value );
-  /// Called to extract the data and place it into the appropriate stack
-  virtual void ExtractData( const RIDS::Event& event,
-                            const unsigned int iBin ) = 0;
-  /// Set the number of bins and stacks
-  void SetNumBinsStacks( const int numBins,
-                         const int numStacks );
+  /// Return the counter to draw, bins are the counter buckets and stacks the counter stacks
+  virtual const RollingCounter& GetCounter() const = 0;
 private:
-  int fNumBins; /// < Number of bins
-  int fNumStacks; /// < Number of stacks
+  int fAdded; /// < Counter added count when last drawn
 };
 
 } // ::Frames
@@ -1,17 +1,14 @@
 #include <Viewer/TriggerStream.hh>
 #include <Viewer/RenderState.hh>
-#include <Viewer/DataSelector.hh>
-#include <Viewer/GUIProperties.hh>
+#include <Viewer/DataStore.hh>
 using namespace Viewer;
 using namespace Viewer::Frames;
-#include <Viewer/RIDS/Event.hh>
 
 void
 TriggerStream::PreInitialise( const ConfigurationTable* configTable )
 {
   HistogramBase::PreInitialise( configTable );
   Initialise();
-  SetNumBinsStacks( 200, 6 );
 }
 
 void
@@ -35,21 +32,8 @@ TriggerStream::EventLoop()
     }
 }
 
-void
-TriggerStream::ExtractData( const RIDS::Event& event, 
-                            const unsigned int iBin )
+const RollingCounter&
+TriggerStream::GetCounter() const
 {
-  const int trigger = event.GetTrigger();
-  if( trigger == 0x0 )
-    fValues[iBin][0] += 1.0;
-  if( trigger & 0x01 || trigger & 0x02 || trigger & 0x04 )
-    fValues[iBin][1] += 1.0;
-  if( trigger & 0x08 || trigger & 0x10 )
-    fValues[iBin][2] += 1.0;
-  if( trigger & 0x20 || trigger & 0x40 )
-    fValues[iBin][3] += 1.0;
-  if( trigger & 0x80 || trigger & 0x100 || trigger & 0x200 )
-    fValues[iBin][4] += 1.0;
-  if( trigger & 0x400 || trigger & 0x800 || trigger & 0x1000 || trigger & 0x2000 || trigger & 0x4000 || trigger & 0x8000 )
-    fValues[iBin][5] += 1.0;
+  return DataStore::GetInstance().GetStreamSummary().GetTriggers();
 }
@@ -8,7 +8,7 @@
 /// REVISION HISTORY:\n
 ///     13/05/12 : P.Jones - First Revision, new file. \n
 ///
-/// \detail  Draws the last 200 seconds of triggers to the screen
+/// \detail  Draws the last 200 seconds of ingested triggers to the screen
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -42,8 +42,7 @@ public:
   
   static std::string Name() { return std::string( "Triggers" ); }
 protected:
-  void ExtractData( const RIDS::Event& event,
-                    const unsigned int iBin );
+  const RollingCounter& GetCounter() const;
 };
 
 } // ::Frames
@@ -1,4 +1,5 @@
 #include <vector>
+#include <sstream>
 using namespace std;
 
 #include <SFML/Graphics/Rect.hpp>
@@ -8,10 +9,15 @@ using namespace std;
 #include <Viewer/ProjectionImage.hh>
 #include <Viewer/RenderState.hh>
 #include <Viewer/DataSelector.hh>
+#include <Viewer/DataStore.hh>
+#include <Viewer/CrateSummary.hh>
 #include <Viewer/RWWrapper.hh>
 #include <Viewer/HitInfo.hh>
+#include <Viewer/Text.hh>
 #include <Viewer/MapArea.hh>
+#include <Viewer/PersistLabel.hh>
 #include <Viewer/BitManip.hh>
+#include <Viewer/ConfigurationTable.hh>
 using namespace Viewer;
 using namespace Viewer::Frames;
 #include <Viewer/RIDS/Channel.hh>
@@ -24,67 +30,157 @@ const int kFullHeight = 2 * kCrateHeight + kMargin + 1;
 
 CrateView::~CrateView()
 {
-  delete fImage, fHitInfo;
+  delete fImage;
+  delete fCrateImage;
+  delete fHitInfo;
+  delete fSummaryInfo;
 }
 
 void 
 CrateView::PreInitialise( const ConfigurationTable* configTable ) 
 {
+  if( configTable != NULL && configTable->Has( "summary" ) )
+    {
+      fSummary = configTable->GetI( "summary" );
+      fCardLevel = configTable->GetI( "cardLevel" );
+    }
   sf::Rect<double> size;
   size.left = 0.0; size.top = 0.0; size.width = 1.0; size.height = 0.95;
   fImage = new ProjectionImage( RectPtr( fRect->NewDaughter( size, Rect::eLocal ) ),
                                 kFullWidth, kFullHeight );
-  fMapArea = fGUIManager.NewGUI<GUIs::MapArea>( size );
-  size.left = 0.0; size.top = 0.95; size.width = 1.0; size.height = 0.05;
+  fCrateImage = new ProjectionImage( RectPtr( fRect->NewDaughter( size, Rect::eLocal ) ),
+                                     kCrateWidth + 1, kCrateHeight + 1 );
+  fMapArea = fGUIManager.NewGUI<GUIs::MapArea>( size, eMapArea );
+  size.left = 0.0; size.top = 0.95; size.width = 0.7; size.height = 0.05;
   fHitInfo = new HitInfo( RectPtr( fRect->NewDaughter( size, Rect::eLocal ) ), true );
+  fSummaryInfo = new Text( RectPtr( fRect->NewDaughter( size, Rect::eLocal ) ) );
+  size.left = 0.7; size.width = 0.15;
+  GUIs::PersistLabel* summary = fGUIManager.NewGUI<GUIs::PersistLabel>( size, eSummary );
+  summary->Initialise( 16, "Summary" );
+  summary->SetState( fSummary );
+  size.left = 0.85;
+  GUIs::PersistLabel* cardLevel = fGUIManager.NewGUI<GUIs::PersistLabel>( size, eCardLevel );
+  cardLevel->Initialise( 16, "Cards" );
+  cardLevel->SetState( fCardLevel );
   fPMTofInterest = -1;
+  fDrillCrate = -1;
+  fSummaryWindow = -1;
+  fEventsAdded = -1;
+  fRedraw = false;
+}
+
+void
+CrateView::SaveConfiguration( ConfigurationTable* configTable )
+{
+  configTable->SetI( "summary", fSummary );
+  configTable->SetI( "cardLevel", fCardLevel );
 }
 
 void
 CrateView::ProcessEvent( const RenderState& renderState )
 {
-  fImage->Clear();
-  // Draw the crate outlines first
-  for( int iCrate = 0; iCrate < 20; iCrate++ ) // 20 Crates
+  fRedraw = false;
+  if( fSummary )
     {
-      int xPos = ( iCrate % 10 ) * ( kCrateWidth + kMargin );
-      int yPos = ( iCrate / 10 ) * ( kCrateHeight + kMargin );
-
-      fImage->DrawHollowSquare( sf::Vector2<int>( xPos, yPos ),
-                                sf::Vector2<int>( kCrateWidth, kCrateHeight ),
-                                GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ),
-                                1 );
+      if( fDrillCrate != -1 )
+        DrawCrateSummary();
+      else
+        DrawSummary();
+      return;
     }
+  fImage->Clear();
+  DrawCrateOutlines();
   // Now draw the hits
-  fPMTofInterest = -1;
   DrawPMTs( renderState );
   fImage->Update();
 }
 
-void 
+void
 CrateView::Render2d( RWWrapper& renderApp,
                      const RenderState& renderState )
 {
-  renderApp.Draw( *fImage );
+  if( fRedraw )
+    ProcessEvent( renderState );
 
-  if( fPMTofInterest != -1 )
+  if( fSummary && fDrillCrate != -1 )
+    renderApp.Draw( *fCrateImage );
+  else
+    renderApp.Draw( *fImage );
+
+  if( fSummary )
+    {
+      SetSummaryInfo();
+      renderApp.Draw( *fSummaryInfo );
+    }
+  else if( fPMTofInterest != -1 )
     fHitInfo->Render( renderApp, renderState, fPMTofInterest );
 }
 
-void 
+void
 CrateView::EventLoop()
 {
   while( !fEvents.empty() )
     {
-      // Only one event type is likely
-      fMousePos = fMapArea->GetPosition();
+      switch( fEvents.front().fguiID )
+        {
+        case eMapArea:
+          {
+            fMousePos = fMapArea->GetPosition();
+            int crate, card, channel;
+            // Picking is independent of drawing, the layout maps the mouse directly to a channel
+            fPMTofInterest = -1;
+            if( !fSummary && GetMouseLocation( crate, card, channel ) )
+              fPMTofInterest = ( crate << 9 ) | ( card << 5 ) | channel;
+            if( fMapArea->GetClicked() && fSummary )
+              {
+                if( fDrillCrate != -1 )
+                  fDrillCrate = -1;
+                else if( GetMouseLocation( crate, card, channel ) )
+                  fDrillCrate = crate;
+                fRedraw = true;
+              }
+          }
+          break;
+        case eSummary:
+          fSummary = dynamic_cast<GUIs::PersistLabel*>( fGUIManager.GetGUI( eSummary ) )->GetState();
+          fDrillCrate = -1;
+          fRedraw = true;
+          break;
+        case eCardLevel:
+          fCardLevel = dynamic_cast<GUIs::PersistLabel*>( fGUIManager.GetGUI( eCardLevel ) )->GetState();
+          fRedraw = true;
+          break;
+        }
       fEvents.pop();
     }
+  if( !fSummary )
+    return;
+  // The summary changes as events are ingested, independent of the event shown
+  const DataStore& dataStore = DataStore::GetInstance();
+  const int windowCount = dataStore.GetCrateSummary().GetWindowCount();
+  if( windowCount != fSummaryWindow ||
+      ( windowCount == 0 && static_cast<int>( dataStore.GetEventsAdded() ) != fEventsAdded ) )
+    fRedraw = true;
+}
+
+void
+CrateView::DrawCrateOutlines()
+{
+  for( int iCrate = 0; iCrate < 20; iCrate++ ) // 20 Crates
+    {
+      int xPos = ( iCrate % 10 ) * ( kCrateWidth + kMargin );
+      int yPos = ( iCrate / 10 ) * ( kCrateHeight + kMargin );
+
+      fImage->DrawHollowSquare( sf::Vector2<int>( xPos, yPos ),
+                                sf::Vector2<int>( kCrateWidth, kCrateHeight ),
+                                GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ),
+                                1 );
+    }
 }
 
 void
 CrateView::DrawPMT( const int lcn,
-                    const Colour& colour )
+                    sf::Uint32 colour )
 {
   int crate = BitManip::GetBits(lcn, 9, 5); 
   int card = BitManip::GetBits(lcn, 5, 4);
@@ -94,25 +190,137 @@ CrateView::DrawPMT( const int lcn,
   fImage->DrawSquare( sf::Vector2<int>( xPos, yPos ),
                       sf::Vector2<int>( 0, 0 ), // Size is just the pixel, no extra
                       colour );
-  // Draw the PMT info as well, first calculate the mouse equivalent position of the pixel
-  const double mouseXPos = static_cast<double>( xPos ) / static_cast<double>( kFullWidth );
-  const double mouseXWidth = 1.0 / static_cast<double>( kFullWidth );
-  const double mouseYPos = static_cast<double>( yPos ) / static_cast<double>( kFullHeight );
-  const double mouseYHeight = 1.0 / static_cast<double>( kFullHeight );
-  if( fMousePos.x > mouseXPos && ( fMousePos.x - mouseXPos ) < mouseXWidth && 
-      fMousePos.y > mouseYPos && ( fMousePos.y - mouseYPos ) < mouseYHeight )
-    fPMTofInterest = lcn;  
 }
 
 void 
 CrateView::DrawPMTs( const RenderState& renderState )
 {
-  const vector<RIDS::Channel> hits = DataSelector::GetInstance().GetData( renderState.GetDataSource(), renderState.GetDataType() );
+  const vector<RIDS::Channel>& hits = DataSelector::GetInstance().GetData( renderState.GetDataSource(), renderState.GetDataType() );
   for( vector<RIDS::Channel>::const_iterator iTer = hits.begin(); iTer != hits.end(); iTer++ )
     {
       const double data = iTer->GetData();
       if( data == 0.0 )
         continue;
-      DrawPMT( iTer->GetID(), renderState.GetDataColour( data ) );
+      DrawPMT( iTer->GetID(), renderState.GetPackedDataColour( data ) );
+    }
+}
+
+void
+CrateView::DrawSummary()
+{
+  const CrateSummary& summary = DataStore::GetInstance().GetCrateSummary();
+  fSummaryWindow = summary.GetWindowCount();
+  fEventsAdded = DataStore::GetInstance().GetEventsAdded();
+  const ColourPalette& palette = GUIProperties::GetInstance().GetColourPalette();
+  const CrateSummary::ELevel level = fCardLevel ? CrateSummary::eCard : CrateSummary::eCrate;
+  const double maxRate = summary.GetMaxRate( level );
+
+  fImage->Clear();
+  DrawCrateOutlines();
+  for( int iCrate = 0; iCrate < CrateSummary::kCrates && maxRate > 0.0; iCrate++ )
+    {
+      const int xPos = ( iCrate % 10 ) * ( kCrateWidth + kMargin ) + 1;
+      const int yPos = ( iCrate / 10 ) * ( kCrateHeight + kMargin ) + 1;
+      if( !fCardLevel )
+        {
+          const double rate = summary.GetRate( CrateSummary::eCrate, iCrate );
+          if( rate > 0.0 )
+            fImage->DrawSquare( sf::Vector2<int>( xPos, yPos ),
+                                sf::Vector2<int>( CrateSummary::kCards - 1, CrateSummary::kChannels - 1 ),
+                                palette.GetPackedColour( rate / maxRate ) );
+          continue;
+        }
+      for( int iCard = 0; iCard < CrateSummary::kCards; iCard++ )
+        {
+          const double rate = summary.GetRate( CrateSummary::eCard, iCrate, iCard );
+          if( rate > 0.0 )
+            fImage->DrawSquare( sf::Vector2<int>( xPos + iCard, yPos ),
+                                sf::Vector2<int>( 0, CrateSummary::kChannels - 1 ),
+                                palette.GetPackedColour( rate / maxRate ) );
+        }
+    }
+  fImage->Update();
+}
+
+void
+CrateView::DrawCrateSummary()
+{
+  const CrateSummary& summary = DataStore::GetInstance().GetCrateSummary();
+  fSummaryWindow = summary.GetWindowCount();
+  fEventsAdded = DataStore::GetInstance().GetEventsAdded();
+  const ColourPalette& palette = GUIProperties::GetInstance().GetColourPalette();
+  const double maxRate = summary.GetMaxRate( CrateSummary::eChannel, fDrillCrate );
+
+  fCrateImage->Clear();
+  fCrateImage->DrawHollowSquare( sf::Vector2<int>( 0, 0 ),
+                                 sf::Vector2<int>( kCrateWidth, kCrateHeight ),
+                                 palette.GetPrimaryColour( eGrey ),
+                                 1 );
+  for( int iCard = 0; iCard < CrateSummary::kCards && maxRate > 0.0; iCard++ )
+    for( int iChannel = 0; iChannel < CrateSummary::kChannels; iChannel++ )
+      {
+        const double rate = summary.GetRate( CrateSummary::eChannel, fDrillCrate, iCard, iChannel );
+        if( rate > 0.0 )
+          fCrateImage->DrawSquare( sf::Vector2<int>( iCard + 1, CrateSummary::kChannels - iChannel ),
+                                   sf::Vector2<int>( 0, 0 ),
+                                   palette.GetPackedColour( rate / maxRate ) );
+      }
+  fCrateImage->Update();
+}
+
+void
+CrateView::SetSummaryInfo()
+{
+  int crate, card, channel;
+  stringstream info;
+  if( GetMouseLocation( crate, card, channel ) )
+    {
+      const CrateSummary& summary = DataStore::GetInstance().GetCrateSummary();
+      CrateSummary::ELevel level = CrateSummary::eCrate;
+      info << "Cr:" << crate;
+      if( fDrillCrate != -1 )
+        {
+          level = CrateSummary::eChannel;
+          info << ":Cd:" << card << ":Ch:" << channel;
+        }
+      else if( fCardLevel )
+        {
+          level = CrateSummary::eCard;
+          info << ":Cd:" << card;
+        }
+      info << "    Rate:" << summary.GetRate( level, crate, card, channel ) << "Hz";
+      info << "    QHL:" << summary.GetMeanCharge( level, crate, card, channel );
+    }
+  else if( fDrillCrate != -1 )
+    info << "Crate " << fDrillCrate << ", click to return";
+  else
+    info << "Click a crate for its channel rates";
+  fSummaryInfo->SetString( info.str() );
+  fSummaryInfo->SetColour( GUIProperties::GetInstance().GetGUIColourPalette().GetText() );
+}
+
+bool
+CrateView::GetMouseLocation( int& crate,
+                             int& card,
+                             int& channel ) const
+{
+  if( fMousePos.x < 0.0 || fMousePos.x >= 1.0 || fMousePos.y < 0.0 || fMousePos.y >= 1.0 )
+    return false;
+  if( fDrillCrate != -1 )
+    {
+      crate = fDrillCrate;
+      card = static_cast<int>( fMousePos.x * ( kCrateWidth + 1 ) ) - 1;
+      channel = CrateSummary::kChannels - static_cast<int>( fMousePos.y * ( kCrateHeight + 1 ) );
+    }
+  else
+    {
+      const int xPos = static_cast<int>( fMousePos.x * kFullWidth );
+      const int yPos = static_cast<int>( fMousePos.y * kFullHeight );
+      crate = ( yPos / ( kCrateHeight + kMargin ) ) * 10 + xPos / ( kCrateWidth + kMargin );
+      card = xPos % ( kCrateWidth + kMargin ) - 1;
+      channel = CrateSummary::kChannels - yPos % ( kCrateHeight + kMargin );
     }
+  return crate >= 0 && crate < CrateSummary::kCrates &&
+    card >= 0 && card < CrateSummary::kCards &&
+    channel >= 0 && channel < CrateSummary::kChannels;
 }
@@ -11,6 +11,8 @@
 ///
 /// \detail  Display the crate hit information, crates are ordered by 
 ///          crate id, then by card horizontally and channel vertically.
+///          In summary mode the ingest rates are shown per crate or per
+///          card, clicking a crate shows its channel rates.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -18,6 +20,7 @@
 #define __Viewer_CrateView__
 
 #include <SFML/System/Vector2.hpp>
+#include <SFML/Config.hpp>
 
 #include <Viewer/Frame2d.hh>
 
@@ -26,6 +29,7 @@ namespace Viewer
   class ProjectionImage;
   class HitInfo;
   class Colour;
+  class Text;
 namespace GUIs
 {
   class MapArea;
@@ -37,7 +41,7 @@ namespace Frames
 class CrateView : public Frame2d
 {
 public:
-  CrateView( RectPtr rect ) : Frame2d( rect ) { }
+  CrateView( RectPtr rect ) : Frame2d( rect ), fSummary( false ), fCardLevel( true ) { }
   ~CrateView();
   
   /// Initialise without using the DataStore
@@ -45,7 +49,7 @@ public:
   /// Initilaise with DataStore access
   void PostInitialise( const ConfigurationTable* configTable ) { };
   /// Save the configuration
-  void SaveConfiguration( ConfigurationTable* configTable ) { };
+  void SaveConfiguration( ConfigurationTable* configTable );
   
   virtual void EventLoop();
   
@@ -65,15 +69,36 @@ public:
 
   double GetAspectRatio() const { return 0.5; }
 private:
+  enum EGUIs { eMapArea, eSummary, eCardLevel };
+
+  void DrawCrateOutlines();
   void DrawPMT( const int lcn,
-		const Colour& colour );
+		sf::Uint32 colour );
   void DrawPMTs( const RenderState& renderState );
+  /// Draw the crate or card rates of all crates
+  void DrawSummary();
+  /// Draw the channel rates of the drill down crate
+  void DrawCrateSummary();
+  /// Set the summary info text for the location under the mouse
+  void SetSummaryInfo();
+  /// Find the crate, card and channel at the mouse position, returns false if none
+  bool GetMouseLocation( int& crate, 
+                         int& card, 
+                         int& channel ) const;
 
   sf::Vector2<double> fMousePos; /// < The mouse position (-1, -1) if not in frame
   int fPMTofInterest; /// < The PMT which is hoverred over
   GUIs::MapArea* fMapArea; /// < The map area gui
   ProjectionImage* fImage; /// < Image of the crates
+  ProjectionImage* fCrateImage; /// < Image of a single crate, for the drill down
   HitInfo* fHitInfo; /// < Hit info
+  Text* fSummaryInfo; /// < Summary info text for the location under the mouse
+  int fDrillCrate; /// < Crate shown in the drill down, -1 if none
+  int fSummaryWindow; /// < CrateSummary window last drawn
+  int fEventsAdded; /// < DataStore events added when last drawn
+  bool fSummary; /// < Show the summary rates rather than the event
+  bool fCardLevel; /// < Summary at card rather than crate level
+  bool fRedraw; /// < Image requires redrawing
 };
 
 }//Frames namespace
@@ -5,8 +5,6 @@
 using namespace std;
 
 #include <Viewer/IcosahedralProjection.hh>
-#include <Viewer/GUIProperties.hh>
-#include <Viewer/ProjectionImage.hh>
 using namespace Viewer;
 using namespace Viewer::Frames;
 
@@ -37,36 +35,36 @@ using namespace Viewer::Frames;
   const TVector2 A54 = TVector2( 7.0 * a / 2.0 , 2.0 * b );
 
 void
-IcosahedralProjection::PostInitialise( const ConfigurationTable* configTable )
+IcosahedralProjection::ProjectOutline( vector< sf::Vector2<double> >& outline )
 {
-  ProjectionMapArea::PostInitialise( configTable );
-  ProjectOutline( A2a, A12a );
-  ProjectOutline( A6, A12a );
-  ProjectOutline( A2b, A12e );
-  ProjectOutline( A27, A12e );
-  ProjectOutline( A27, A12d );
-  ProjectOutline( A46, A12d );
-  ProjectOutline( A46, A12c );
-  ProjectOutline( A31, A12c );
-  ProjectOutline( A31, A12b );
-  ProjectOutline( A6, A12b );
-  ProjectOutline( A51a, A17a );
-  ProjectOutline( A2a, A17a );
-  ProjectOutline( A2b, A17b );
-  ProjectOutline( A51e, A17b );
-  ProjectOutline( A51e, A37 );
-  ProjectOutline( A51d, A37 );
-  ProjectOutline( A51d, A54 );
-  ProjectOutline( A51c, A54 );
-  ProjectOutline( A51c, A58 );
-  ProjectOutline( A51b, A58 );
-  ProjectOutline( A51b, A33 );
-  ProjectOutline( A33, A51a );
+  ProjectOutline( A2a, A12a, outline );
+  ProjectOutline( A6, A12a, outline );
+  ProjectOutline( A2b, A12e, outline );
+  ProjectOutline( A27, A12e, outline );
+  ProjectOutline( A27, A12d, outline );
+  ProjectOutline( A46, A12d, outline );
+  ProjectOutline( A46, A12c, outline );
+  ProjectOutline( A31, A12c, outline );
+  ProjectOutline( A31, A12b, outline );
+  ProjectOutline( A6, A12b, outline );
+  ProjectOutline( A51a, A17a, outline );
+  ProjectOutline( A2a, A17a, outline );
+  ProjectOutline( A2b, A17b, outline );
+  ProjectOutline( A51e, A17b, outline );
+  ProjectOutline( A51e, A37, outline );
+  ProjectOutline( A51d, A37, outline );
+  ProjectOutline( A51d, A54, outline );
+  ProjectOutline( A51c, A54, outline );
+  ProjectOutline( A51c, A58, outline );
+  ProjectOutline( A51b, A58, outline );
+  ProjectOutline( A51b, A33, outline );
+  ProjectOutline( A33, A51a, outline );
 }
 
 void
 IcosahedralProjection::ProjectOutline( TVector2 v1,
-                                       TVector2 v2 )
+                                       TVector2 v2,
+                                       vector< sf::Vector2<double> >& outline )
 {
   TVector2 line = v2 - v1;
   double dist = line.Mod();
@@ -74,174 +72,137 @@ IcosahedralProjection::ProjectOutline( TVector2 v1,
   for( double delta = 0.0; delta < dist; delta += dist / 60.0 )
     {
       TVector2 deltaPos = line * delta + v1;
-      fProjectedOutline.push_back( sf::Vector2<double>( deltaPos.X(), 2.0 * deltaPos.Y() ) );
+      outline.push_back( sf::Vector2<double>( deltaPos.X(), 2.0 * deltaPos.Y() ) );
     }
 }
 
-void
-IcosahedralProjection::DrawOutline()
+/// Precomputed projection data for an icosahedron face
+struct Face
 {
-  for( vector< sf::Vector2<double> >::iterator iTer = fProjectedOutline.begin(); iTer != fProjectedOutline.end(); iTer++ )
-    fImage->DrawDot( *iTer, GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ) );
-}
-
-TVector2
-TransformCoord( const TVector3& V1,
-                const TVector3& V2,
-                const TVector3& V3,
-                const TVector2& A1,
-                const TVector2& A2,
-                const TVector2& A3,
-                const TVector3& P )
+  double fCentre[3]; /// < Face centre, the nearest centre defines the face
+  double fNormal[3]; /// < Unit normal
+  double fPlaneD; /// < Plane distance along the normal
+  double fOrigin[3]; /// < First vertex
+  double fX[3]; /// < Unit face x axis
+  double fY[3]; /// < Unit face y axis
+  double fA1[2]; /// < First vertex in the projection
+  double fXA[2]; /// < Projection x axis, scaled by the unit conversion
+  double fYA[2]; /// < Projection y axis, scaled by the unit conversion
+};
+
+Face
+MakeFace( const TVector3& V1,
+          const TVector3& V2,
+          const TVector3& V3,
+          const TVector2& A1,
+          const TVector2& A2,
+          const TVector2& A3 )
 {
-  TVector3 xV = V2 - V1;
-  TVector3 yV = ( ( V3 - V1 ) + ( V3 - V2 ) ) * 0.5;
-  TVector3 zV = xV.Cross( yV ).Unit();
-
-  double planeD = V1.Dot( zV );
-
-  double t = planeD / P.Dot( zV );
-
-  TVector3 localP = t*P - V1;
-
-  TVector2 xA = A2 - A1;
-  TVector2 yA = ( ( A3 - A1 ) +( A3 - A2 ) )  * 0.5;
-
-  double convUnits = xA.Mod() / xV.Mag();
-
-  TVector2 result;
-  result = localP.Dot( xV.Unit() ) * xA.Unit() * convUnits;
-  result += localP.Dot( yV.Unit() ) * yA.Unit() * convUnits + A1;
-  return result;
+  const TVector3 centre = ( V1 + V2 + V3 ) * ( 1.0 / 3.0 );
+  const TVector3 xV = V2 - V1;
+  const TVector3 yV = ( ( V3 - V1 ) + ( V3 - V2 ) ) * 0.5;
+  const TVector3 zV = xV.Cross( yV ).Unit();
+  const TVector2 xA = A2 - A1;
+  const TVector2 yA = ( ( A3 - A1 ) + ( A3 - A2 ) ) * 0.5;
+  const double convUnits = xA.Mod() / xV.Mag();
+  const TVector2 xAScaled = xA.Unit() * convUnits;
+  const TVector2 yAScaled = yA.Unit() * convUnits;
+
+  Face face;
+  face.fCentre[0] = centre.x(); face.fCentre[1] = centre.y(); face.fCentre[2] = centre.z();
+  face.fNormal[0] = zV.x(); face.fNormal[1] = zV.y(); face.fNormal[2] = zV.z();
+  face.fPlaneD = V1.Dot( zV );
+  face.fOrigin[0] = V1.x(); face.fOrigin[1] = V1.y(); face.fOrigin[2] = V1.z();
+  face.fX[0] = xV.Unit().x(); face.fX[1] = xV.Unit().y(); face.fX[2] = xV.Unit().z();
+  face.fY[0] = yV.Unit().x(); face.fY[1] = yV.Unit().y(); face.fY[2] = yV.Unit().z();
+  face.fA1[0] = A1.X(); face.fA1[1] = A1.Y();
+  face.fXA[0] = xAScaled.X(); face.fXA[1] = xAScaled.Y();
+  face.fYA[0] = yAScaled.X(); face.fYA[1] = yAScaled.Y();
+  return face;
 }
 
-TVector2
-ToSpherical( const TVector3& P )
+/// The 20 faces, built once on static initialisation
+class Faces
 {
-  double theta = acos( P.z() / P.Mag() );
-  double phi = atan2( P.y(), P.x() );
-  return TVector2( theta, phi );
-}
+public:
+  Faces()
+  {
+    // From http://www.rwgrayprojects.com/rbfnotes/polyhed/PolyhedraData/Icosahedralsahedron/Icosahedralsahedron.pdf
+    const double t = ( 1.0 + sqrt( 5.0 ) ) / 2.0;
+
+    const TVector3 V2 = TVector3( t * t, 0.0, t * t * t ).Unit();
+    const TVector3 V6 = TVector3( -t * t, 0.0, t * t * t ).Unit();
+    const TVector3 V12 = TVector3( 0.0, t * t * t, t * t ).Unit();
+    const TVector3 V17 = TVector3( 0.0, -t * t * t, t * t ).Unit();
+    const TVector3 V27 = TVector3( t * t * t, t * t, 0.0 ).Unit();
+    const TVector3 V31 = TVector3( -t * t * t, t * t, 0.0 ).Unit();
+    const TVector3 V33 = TVector3( -t * t * t, -t * t, 0.0 ).Unit();
+    const TVector3 V37 = TVector3( t * t * t, -t * t, 0.0 ).Unit();
+    const TVector3 V46 = TVector3( 0.0, t * t * t, -t * t ).Unit();
+    const TVector3 V51 = TVector3( 0.0, -t * t * t, -t * t ).Unit();
+    const TVector3 V54 = TVector3( t * t, 0.0, -t * t * t ).Unit();
+    const TVector3 V58 = TVector3( -t * t, 0.0, -t * t * t ).Unit();
+    fFaces[0] = MakeFace( V2, V6, V17, A2a, A6, A17a );
+    fFaces[1] = MakeFace( V2, V12, V6, A2a, A12a, A6 );
+    fFaces[2] = MakeFace( V2, V17, V37, A2b, A17b, A37 );
+    fFaces[3] = MakeFace( V2, V37, V27, A2b, A37, A27 );
+    fFaces[4] = MakeFace( V2, V27, V12, A2b, A27, A12e );
+    fFaces[5] = MakeFace( V37, V54, V27, A37, A54, A27 );
+    fFaces[6] = MakeFace( V27, V54, V46, A27, A54, A46 );
+    fFaces[7] = MakeFace( V27, V46, V12, A27, A46, A12d );
+    fFaces[8] = MakeFace( V12, V46, V31, A12c, A46, A31 );
+    fFaces[9] = MakeFace( V12, V31, V6, A12b, A31, A6 );
+    fFaces[10] = MakeFace( V6, V31, V33, A6, A31, A33 );
+    fFaces[11] = MakeFace( V6, V33, V17, A6, A33, A17a );
+    fFaces[12] = MakeFace( V17, V33, V51, A17a, A33, A51a );
+    fFaces[13] = MakeFace( V17, V51, V37, A17b, A51e, A37 );
+    fFaces[14] = MakeFace( V37, V51, V54, A37, A51d, A54 );
+    fFaces[15] = MakeFace( V58, V54, V51, A58, A54, A51c );
+    fFaces[16] = MakeFace( V58, V46, V54, A58, A46, A54 );
+    fFaces[17] = MakeFace( V58, V31, V46, A58, A31, A46 );
+    fFaces[18] = MakeFace( V58, V33, V31, A58, A33, A31 );
+    fFaces[19] = MakeFace( V58, V51, V33, A58, A51b, A33 );
+  }
+  Face fFaces[20];
+};
+
+const Faces kFaces;
+// The sphere is rotated about x by -45 (radians, as TVector3::RotateX) before projecting
+const double kRotateCos = cos( -45.0 );
+const double kRotateSin = sin( -45.0 );
 
-sf::Vector2<double>
-IcosahedralProjection::Project( sf::Vector3<double> pmtPos )
+void
+IcosahedralProjection::Project( const double* xyz,
+                                size_t count,
+                                double* uv )
 {
-  TVector3 pointOnSphere( pmtPos.x, pmtPos.y, pmtPos.z );
-  pointOnSphere = pointOnSphere.Unit();
-  pointOnSphere.RotateX( -45.0 );
-  // From http://www.rwgrayprojects.com/rbfnotes/polyhed/PolyhedraData/Icosahedralsahedron/Icosahedralsahedron.pdf
-  const double t = ( 1.0 + sqrt( 5.0 ) ) / 2.0;
-
-  const TVector3 V2 = TVector3( t * t, 0.0, t * t * t ).Unit();
-  const TVector3 V6 = TVector3( -t * t, 0.0, t * t * t ).Unit();
-  const TVector3 V12 = TVector3( 0.0, t * t * t, t * t ).Unit();
-  const TVector3 V17 = TVector3( 0.0, -t * t * t, t * t ).Unit();
-  const TVector3 V27 = TVector3( t * t * t, t * t, 0.0 ).Unit();
-  const TVector3 V31 = TVector3( -t * t * t, t * t, 0.0 ).Unit();
-  const TVector3 V33 = TVector3( -t * t * t, -t * t, 0.0 ).Unit();
-  const TVector3 V37 = TVector3( t * t * t, -t * t, 0.0 ).Unit();
-  const TVector3 V46 = TVector3( 0.0, t * t * t, -t * t ).Unit();
-  const TVector3 V51 = TVector3( 0.0, -t * t * t, -t * t ).Unit();
-  const TVector3 V54 = TVector3( t * t, 0.0, -t * t * t ).Unit();
-  const TVector3 V58 = TVector3( -t * t, 0.0, -t * t * t ).Unit();
-  // Faces {{ 2, 6, 17}, { 2, 12, 6}, { 2, 17, 37}, { 2, 37, 27}, { 2, 27, 12}, {37, 54, 27},
-  // {27, 54, 46}, {27, 46, 12}, {12, 46, 31}, {12, 31, 6}, { 6, 31, 33}, { 6, 33, 17},
-  // {17, 33, 51}, {17, 51, 37}, {37, 51, 54}, {58, 54, 51}, {58, 46, 54}, {58, 31, 46},
-  // {58, 33, 31}, {58, 51, 33}}
-  vector<TVector3> IcosahedralCentres;
-  IcosahedralCentres.push_back( ( V2 + V6 + V17 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V2 + V12 + V6 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V2 + V17 + V37 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V2 + V37 + V27 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V2 + V27 + V12 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V37 + V54 + V27 ) * ( 1.0 / 3.0 ) );
-
-  IcosahedralCentres.push_back( ( V27 + V54 + V46 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V27 + V46 + V12 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V12 + V46 + V31 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V12 + V31 + V6 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V6 + V31 + V33 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V6 + V33 + V17 ) * ( 1.0 / 3.0 ) );
-
-  IcosahedralCentres.push_back( ( V17 + V33 + V51 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V17 + V51 + V37 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V37 + V51 + V54 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V58 + V54 + V51 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V58 + V46 + V54 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V58 + V31 + V46 ) * ( 1.0 / 3.0 ) );
-
-  IcosahedralCentres.push_back( ( V58 + V33 + V31 ) * ( 1.0 / 3.0 ) );
-  IcosahedralCentres.push_back( ( V58 + V51 + V33 ) * ( 1.0 / 3.0 ) );
-
-  vector<double> distFromCentre;
-  unsigned int uLoop;
-  for( uLoop = 0; uLoop < IcosahedralCentres.size(); uLoop++ )
-    distFromCentre.push_back( ( IcosahedralCentres[uLoop] - pointOnSphere ).Mag() );
-  const int face = min_element( distFromCentre.begin(), distFromCentre.end() ) - distFromCentre.begin() + 1;
-
-  TVector2 resultPosition;
-  switch(face)
+  for( size_t iPos = 0; iPos < count; iPos++ )
     {
-    case 1://{ 2, 6, 17}
-      resultPosition = TransformCoord( V2, V6, V17, A2a, A6, A17a, pointOnSphere );
-      break;
-    case 2://{ 2, 12, 6}
-      resultPosition = TransformCoord( V2, V12, V6, A2a, A12a, A6, pointOnSphere );
-      break;
-    case 3://{ 2, 17, 37}
-      resultPosition = TransformCoord( V2, V17, V37, A2b, A17b, A37, pointOnSphere );
-      break;
-    case 4://{ 2, 37, 27}
-      resultPosition = TransformCoord( V2, V37, V27, A2b, A37, A27, pointOnSphere );
-      break;
-    case 5://{ 2, 27, 12}
-      resultPosition = TransformCoord( V2, V27, V12, A2b, A27, A12e, pointOnSphere );
-      break;
-    case 6://{37, 54, 27}
-      resultPosition = TransformCoord( V37, V54, V27, A37, A54, A27, pointOnSphere );
-      break;
-    case 7://{27, 54, 46}
-      resultPosition = TransformCoord( V27, V54, V46, A27, A54, A46, pointOnSphere );
-      break;
-    case 8://{27, 46, 12}
-      resultPosition = TransformCoord( V27, V46, V12, A27, A46, A12d, pointOnSphere );
-      break;
-    case 9://{12, 46, 31}
-      resultPosition = TransformCoord( V12, V46, V31, A12c, A46, A31, pointOnSphere );
-      break;
-    case 10://{12, 31, 6}
-      resultPosition = TransformCoord( V12, V31, V6, A12b, A31, A6, pointOnSphere );
-      break;
-    case 11://{ 6, 31, 33}
-      resultPosition = TransformCoord( V6, V31, V33, A6, A31, A33, pointOnSphere );
-      break;
-    case 12://{ 6, 33, 17}
-      resultPosition = TransformCoord( V6, V33, V17, A6, A33, A17a, pointOnSphere );
-      break;
-    case 13://{17, 33, 51}
-      resultPosition = TransformCoord( V17, V33, V51, A17a, A33, A51a, pointOnSphere );
-      break;
-    case 14://{17, 51, 37}
-      resultPosition = TransformCoord( V17, V51, V37, A17b, A51e, A37, pointOnSphere );
-      break;
-    case 15://{37, 51, 54}
-      resultPosition = TransformCoord( V37, V51, V54, A37, A51d, A54, pointOnSphere );
-      break;
-    case 16://{58, 54, 51}
-      resultPosition = TransformCoord( V58, V54, V51, A58, A54, A51c, pointOnSphere );
-      break;
-    case 17://{58, 46, 54}
-      resultPosition = TransformCoord( V58, V46, V54, A58, A46, A54, pointOnSphere );
-      break;
-    case 18://{58, 31, 46}
-      resultPosition = TransformCoord( V58, V31, V46, A58, A31, A46, pointOnSphere );
-      break;
-    case 19://{58, 33, 31}
-      resultPosition = TransformCoord( V58, V33, V31, A58, A33, A31, pointOnSphere );
-      break;
-    case 20://{58, 51, 33}
-      resultPosition = TransformCoord( V58, V51, V33, A58, A51b, A33, pointOnSphere );
-      break;
+      const double mag2 = xyz[iPos * 3] * xyz[iPos * 3] + xyz[iPos * 3 + 1] * xyz[iPos * 3 + 1] + xyz[iPos * 3 + 2] * xyz[iPos * 3 + 2];
+      const double invMag = mag2 > 0.0 ? 1.0 / sqrt( mag2 ) : 1.0; // As TVector3::Unit, the zero vector stays zero
+      const double p[3] = { xyz[iPos * 3] * invMag,
+                            ( kRotateCos * xyz[iPos * 3 + 1] - kRotateSin * xyz[iPos * 3 + 2] ) * invMag,
+                            ( kRotateSin * xyz[iPos * 3 + 1] + kRotateCos * xyz[iPos * 3 + 2] ) * invMag };
+      // All face centres are equidistant from the origin, so the nearest centre has the largest dot product
+      int nearest = 0;
+      double maxDot = -2.0;
+      for( int iFace = 0; iFace < 20; iFace++ )
+        {
+          const double* centre = kFaces.fFaces[iFace].fCentre;
+          const double dot = centre[0] * p[0] + centre[1] * p[1] + centre[2] * p[2];
+          if( dot > maxDot )
+            {
+              maxDot = dot;
+              nearest = iFace;
+            }
+        }
+      const Face& face = kFaces.fFaces[nearest];
+      // Project onto the face plane, then into the face coordinates
+      const double t = face.fPlaneD / ( p[0] * face.fNormal[0] + p[1] * face.fNormal[1] + p[2] * face.fNormal[2] );
+      const double local[3] = { t * p[0] - face.fOrigin[0], t * p[1] - face.fOrigin[1], t * p[2] - face.fOrigin[2] };
+      const double localX = local[0] * face.fX[0] + local[1] * face.fX[1] + local[2] * face.fX[2];
+      const double localY = local[0] * face.fY[0] + local[1] * face.fY[1] + local[2] * face.fY[2];
+      uv[iPos * 2] = localX * face.fXA[0] + localY * face.fYA[0] + face.fA1[0];
+      uv[iPos * 2 + 1] = 2.0 * ( localX * face.fXA[1] + localY * face.fYA[1] + face.fA1[1] );
     }
-  return sf::Vector2<double>( resultPosition.X(), 2.0 * resultPosition.Y() );
 }
@@ -34,22 +34,25 @@ class IcosahedralProjection : public ProjectionMapArea
 public:
   IcosahedralProjection( RectPtr rect ) : ProjectionMapArea( rect ) { }
 
-  void PostInitialise( const ConfigurationTable* configTable );
-
   std::string GetName() { return IcosahedralProjection::Name(); }
 
   static std::string Name() { return std::string( "Icosahedral" ); }
 
   double GetAspectRatio() const { return 0.5; }
-private:
-  void DrawOutline();
 
-  sf::Vector2<double> Project( sf::Vector3<double> pmtPos );
+  /// Project interleaved xyz positions into interleaved local uv coords, thread safe
+  static void Project( const double* xyz,
+                       size_t count,
+                       double* uv );
+private:
+  ProjectionCache::ProjectFunction GetProjectFunction() const { return &IcosahedralProjection::Project; }
+  ProjectionCache::OutlineFunction GetOutlineFunction() const { return &IcosahedralProjection::ProjectOutline; }
 
-  void ProjectOutline( TVector2 v1,
-                       TVector2 v2 );
+  static void ProjectOutline( std::vector< sf::Vector2<double> >& outline );
   
-  std::vector< sf::Vector2<double> > fProjectedOutline; /// < The outline of the projection
+  static void ProjectOutline( TVector2 v1,
+                              TVector2 v2,
+                              std::vector< sf::Vector2<double> >& outline );
 };
 
 } // ::Frames
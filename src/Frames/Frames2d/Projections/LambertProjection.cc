@@ -1,5 +1,3 @@
-#include <TVector3.h>
-
 #include <cmath>
 using namespace std;
 
@@ -7,12 +5,22 @@ using namespace std;
 using namespace Viewer;
 using namespace Viewer::Frames;
 
-sf::Vector2<double>
-LambertProjection::Project( sf::Vector3<double> channelPos )
+void
+LambertProjection::Project( const double* xyz,
+                            size_t count,
+                            double* uv )
 {
-  TVector3 pmtPos( channelPos.x, channelPos.y, channelPos.z );
-  pmtPos = pmtPos.Unit();
-  const double x = sqrt( 2 / ( 1 - pmtPos.z() ) ) * pmtPos.x() / 4.0 + 0.5; // Projected circle radius is 2 thus diameter 4
-  const double y = sqrt( 2 / ( 1 - pmtPos.z() ) ) * pmtPos.y() / 4.0 + 0.5; // +0.5 such that x,y E [0, 1)
-  return sf::Vector2<double>( x, y );
+  // Branch free plain loop over flat arrays, such that the compiler can vectorise it
+  for( size_t iPos = 0; iPos < count; iPos++ )
+    {
+      const double x = xyz[iPos * 3];
+      const double y = xyz[iPos * 3 + 1];
+      const double z = xyz[iPos * 3 + 2];
+      const double mag2 = x * x + y * y + z * z;
+      const double invMag = mag2 > 0.0 ? 1.0 / sqrt( mag2 ) : 1.0; // As TVector3::Unit, the zero vector stays zero
+      // Projected circle radius is 2 thus diameter 4, +0.5 such that x,y E [0, 1)
+      const double scale = sqrt( 2.0 / ( 1.0 - z * invMag ) ) * invMag / 4.0;
+      uv[iPos * 2] = x * scale + 0.5;
+      uv[iPos * 2 + 1] = y * scale + 0.5;
+    }
 }
@@ -33,8 +33,12 @@ public:
 
   static std::string Name() { return std::string( "Lambert" ); }
 
+  /// Project interleaved xyz positions into interleaved local uv coords, thread safe
+  static void Project( const double* xyz,
+                       size_t count,
+                       double* uv );
 private:
-  sf::Vector2<double> Project( sf::Vector3<double> pmtPos );
+  ProjectionCache::ProjectFunction GetProjectFunction() const { return &LambertProjection::Project; }
 };
 
 } // ::Frames
@@ -2,19 +2,20 @@
 #include <RAT/DS/PMTProperties.hh>
 
 #include <cmath>
+#include <algorithm>
 using namespace std;
 
 #include <SFML/Graphics/Rect.hpp>
 
 #include <Viewer/ProjectionBase.hh>
 #include <Viewer/GUIProperties.hh>
-#include <Viewer/GeodesicSphere.hh>
 #include <Viewer/ProjectionImage.hh>
+#include <Viewer/InstancedHits.hh>
+#include <Viewer/ConfigurationTable.hh>
 #include <Viewer/RWWrapper.hh>
 #include <Viewer/RenderState.hh>
 #include <Viewer/DataSelector.hh>
-#include <Viewer/Polyhedron.hh>
-#include <Viewer/Polygon.hh>
+#include <Viewer/FramePacer.hh>
 using namespace Viewer;
 using namespace Viewer::Frames;
 #include <Viewer/RIDS/Event.hh>
@@ -22,10 +23,14 @@ using namespace Viewer::Frames;
 
 const double kPSUPRadius = 8500.0;
 const double kLocalSize = 137.0 * 0.3 / kPSUPRadius;
+const double kResizeDelay = 0.25; // Seconds the on screen size must be stable before the image is reallocated
 
 ProjectionBase::~ProjectionBase()
 {
-  
+  ProjectionCache::GetInstance().Release( fProjection );
+  delete fRaster;
+  delete fInstancedHits;
+  delete fImage;
 }
 
 void
@@ -46,17 +51,23 @@ void
 ProjectionBase::Initialise( const sf::Rect<double>& size )
 {
   ProcessRun();
-  fImage = new ProjectionImage( RectPtr( fRect->NewDaughter( size, Rect::eLocal ) ), 1000, 600 );
+  RectPtr imageRect( fRect->NewDaughter( size, Rect::eLocal ) );
+  fTargetSize = GetImageSize( imageRect );
+  fImage = new ProjectionImage( imageRect, fTargetSize.x, fTargetSize.y );
   fImage->SetSquareSize( sf::Vector2<double>( 1.5 * kLocalSize * GetAspectRatio(), 1.5 * kLocalSize ) );
-
-  const VBO& geodesicVBO = GeodesicSphere::GetInstance()->OutlineVBO();
-  for( unsigned short i = 0; i < geodesicVBO.fIndices.size(); i+=2 )
+  if( GUIProperties::GetInstance().GetConfiguration( "Rendering" )->GetS( "projection" ) == string( "gpu" ) )
     {
-      Vertex::Data start = geodesicVBO.fVertices[ geodesicVBO.fIndices[i] ];
-      Vertex::Data end = geodesicVBO.fVertices[ geodesicVBO.fIndices[i+1] ];
-      ProjectGeodesicLine( sf::Vector3<double>( start.x, start.y, start.z ),
-                           sf::Vector3<double>( end.x, end.y, end.z ) );
+      fInstancedHits = new InstancedHits( fImage->GetRect() );
+      if( fInstancedHits->IsValid() )
+        fInstancedHits->SetSquareSize( fImage->GetSquareSize() ); // Positions are set once the projection is ready
+      else
+        {
+          delete fInstancedHits; // Not supported, draw on the CPU
+          fInstancedHits = NULL;
+        }
     }
+  if( fInstancedHits == NULL )
+    fRaster = new ProjectionRaster();
 }
 
 void 
@@ -71,71 +82,203 @@ ProjectionBase::EventLoop()
 void
 ProjectionBase::ProcessEvent( const RenderState& renderState )
 {
-  fImage->Clear();
-
-  DrawGeodesic();
-  DrawHits( renderState );
-  DrawOutline();
+  if( !ProjectionReady() )
+    {
+      // Draw nothing rather than the last run's projection, Render2d will call again once ready
+      fImage->Clear();
+      fImage->Update();
+      if( fRaster != NULL )
+        fStaleSequence = fRaster->GetSequence(); // Any raster in flight is of the last run
+      fPending = true;
+      return;
+    }
+  fPending = false;
+  // The background must be redrawn if the colours have changed (possibly whilst on another desktop)
+  const pair<sf::Uint32, sf::Uint32> colours( PixelImage::PackColour( GUIProperties::GetInstance().GetGUIColourPalette().GetBackground() ),
+                                              PixelImage::PackColour( GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ) ) );
+  const bool backgroundChanged = fBackgroundDirty || colours != fBackgroundColours;
+  if( backgroundChanged )
+    {
+      fBackgroundColours = colours;
+      DrawBackground();
+      // Show the new background whilst the hits are drawn (or if drawn on the GPU)
+      fImage->Update();
+    }
+  if( fInstancedHits != NULL )
+    {
+      // Only the background is in the image, the hits are drawn on the GPU
+      fInstancedHits->SetHits( DataSelector::GetInstance().GetData( renderState.GetDataSource(), renderState.GetDataType() ), renderState );
+      return;
+    }
+  // The image keeps the last hits until the new raster is uploaded
+  if( backgroundChanged )
+    {
+      fRaster->SetBackground( fImage->GetPixels(), fImage->GetWidth(), fImage->GetHeight(), fImage->GetPixelSquareSize() );
+      fStaleSequence = fRaster->GetSequence(); // Any raster in flight is over the old background
+    }
+  SubmitHits( renderState );
+}
 
-  fImage->Update();
+void
+ProjectionBase::ProcessScaling( const RenderState& renderState )
+{
+  // The background colour may have changed, ProcessEvent redraws it as required
+  if( fInstancedHits == NULL || fPending || fBackgroundDirty || GUIProperties::GetInstance().HasChanged() )
+    {
+      ProcessEvent( renderState );
+      return;
+    }
+  fInstancedHits->SetScaling( renderState );
 }
 
 void
 ProjectionBase::ProcessRun()
 {
-  const RIDS::ChannelList& channelList = DataSelector::GetInstance().GetChannelList();
-  for( int ipmt = 0; ipmt < channelList.GetChannelCount(); ipmt++ )
-    fProjectedPMTs.push_back( Project( channelList.GetPosition( ipmt ) ) );
+  const DataSelector& dataSelector = DataSelector::GetInstance();
+  ProjectionCache& projectionCache = ProjectionCache::GetInstance();
+  // Acquire before releasing, such that a shared projection for the same run is not deleted
+  const ProjectionCache::Projection* projection = projectionCache.Acquire( GetName(), dataSelector.GetEvent().GetRunID(),
+                                                                           dataSelector.GetChannelList(),
+                                                                           GetProjectFunction(), GetOutlineFunction() );
+  projectionCache.Release( fProjection );
+  fProjection = projection;
+  fProjectionReady = false;
+  fBackgroundDirty = true;
+}
+
+bool
+ProjectionBase::ProjectionReady()
+{
+  if( fProjectionReady )
+    return true;
+  if( fProjection == NULL || !ProjectionCache::GetInstance().IsReady( fProjection ) )
+    return false;
+  fProjectionReady = true;
+  if( fInstancedHits != NULL )
+    fInstancedHits->SetPositions( fProjection->fPMTs );
+  fBackgroundDirty = true;
+  return true;
 }
 
 void
 ProjectionBase::Render2d( RWWrapper& windowApp,
 			  const RenderState& renderState )
 {
+  if( CheckImageSize() || ( fPending && ProjectionReady() ) )
+    ProcessEvent( renderState );
+  UploadRaster();
   windowApp.Draw( *fImage );
+  if( fInstancedHits != NULL )
+    windowApp.Draw( *fInstancedHits );
 }
 
 void
 ProjectionBase::DrawAllPMTs()
 {
-  for( vector< sf::Vector2<double> >::iterator iTer = fProjectedPMTs.begin(); iTer != fProjectedPMTs.end(); iTer++ )
+  for( vector< sf::Vector2<double> >::const_iterator iTer = fProjection->fPMTs.begin(); iTer != fProjection->fPMTs.end(); iTer++ )
     fImage->DrawHollowSquare( *iTer, GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ) );
 }
 
 void
 ProjectionBase::DrawGeodesic()
 {
-  for( vector< sf::Vector2<double> >::iterator iTer = fProjectedGeodesic.begin(); iTer != fProjectedGeodesic.end(); iTer++ )
+  for( vector< sf::Vector2<double> >::const_iterator iTer = fProjection->fGeodesic.begin(); iTer != fProjection->fGeodesic.end(); iTer++ )
     fImage->DrawDot( *iTer, GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ) );
 }
 
 void
-ProjectionBase::ProjectGeodesicLine( sf::Vector3<double> vv1, 
-                                     sf::Vector3<double> vv2 )
-{
-  TVector3 v1( vv1.x, vv1.y, vv1.z );
-  TVector3 v2( vv2.x, vv2.y, vv2.z );
-  TVector3 line = v2 - v1;
-  double dist = line.Mag();
-  line = line.Unit();
-  for( double delta = 0.0; delta < dist; delta += dist / 30.0 )
+ProjectionBase::DrawOutline()
+{
+  for( vector< sf::Vector2<double> >::const_iterator iTer = fProjection->fOutline.begin(); iTer != fProjection->fOutline.end(); iTer++ )
+    fImage->DrawDot( *iTer, GUIProperties::GetInstance().GetColourPalette().GetPrimaryColour( eGrey ) );
+}
+
+void
+ProjectionBase::DrawBackground()
+{
+  fImage->Clear();
+  DrawGeodesic();
+  DrawOutline();
+  fImage->SaveBackground();
+  fBackgroundDirty = false;
+}
+
+sf::Vector2<int>
+ProjectionBase::GetImageSize( RectPtr rect ) const
+{
+  const sf::Rect<double> resolution = rect->GetRect( Rect::eResolution );
+  double width = max( resolution.width, 1.0 );
+  double height = max( resolution.height, 1.0 );
+  const double maxPixels = GUIProperties::GetInstance().GetConfiguration( "Rendering" )->GetI( "projectionPixels" );
+  if( width * height > maxPixels )
     {
-      const TVector3 deltaPos = line * delta + v1;
-      fProjectedGeodesic.push_back( Project( sf::Vector3<double>( deltaPos.x(), deltaPos.y(), deltaPos.z() ) ) );
+      const double scale = sqrt( maxPixels / ( width * height ) );
+      width *= scale;
+      height *= scale;
     }
+  return sf::Vector2<int>( max( static_cast<int>( width ), 1 ), max( static_cast<int>( height ), 1 ) );
+}
+
+bool
+ProjectionBase::CheckImageSize()
+{
+  const sf::Vector2<int> imageSize = GetImageSize( fImage->GetRect() );
+  if( imageSize != fTargetSize )
+    {
+      // Still resizing, wait for it to settle rather than reallocating every frame
+      fTargetSize = imageSize;
+      fResizeClock.restart();
+      return false;
+    }
+  if( fTargetSize.x == fImage->GetWidth() && fTargetSize.y == fImage->GetHeight() )
+    return false;
+  if( fResizeClock.getElapsedTime().asSeconds() < kResizeDelay )
+    {
+      FramePacer::GetInstance().InvalidateIn( kResizeDelay - fResizeClock.getElapsedTime().asSeconds() );
+      return false;
+    }
+  fImage->Resize( fTargetSize.x, fTargetSize.y );
+  if( fInstancedHits != NULL )
+    fInstancedHits->SetSquareSize( fImage->GetSquareSize() );
+  fBackgroundDirty = true;
+  return true;
 }
 
 void
-ProjectionBase::DrawHits( const RenderState& renderState )
+ProjectionBase::SubmitHits( const RenderState& renderState )
 {
   const vector<RIDS::Channel>& hits = DataSelector::GetInstance().GetData( renderState.GetDataSource(), renderState.GetDataType() );
-  for( vector<RIDS::Channel>::const_iterator iTer = hits.begin(); iTer != hits.end(); iTer++ )
+  vector<double> values( hits.size() );
+  for( size_t iHit = 0; iHit < hits.size(); iHit++ )
+    values[iHit] = hits[iHit].GetData();
+  vector<sf::Uint32> colours;
+  renderState.MapColours( values, colours );
+  fSquares.clear();
+  fSquares.reserve( hits.size() );
+  for( size_t iHit = 0; iHit < hits.size(); iHit++ )
     {
-      const sf::Vector2<double> projPos = fProjectedPMTs[iTer->GetID()];
-      const double data = iTer->GetData();
-      if( data == 0.0 )
+      if( values[iHit] == 0.0 )
         continue;
-      fImage->DrawSquare( projPos, renderState.GetDataColour( data ) );
+      const sf::Vector2<double>& position = fProjection->fPMTs[hits[iHit].GetID()];
+      ProjectionRaster::Square square;
+      square.fX = static_cast<int>( position.x * fImage->GetWidth() );
+      square.fY = static_cast<int>( position.y * fImage->GetHeight() );
+      square.fColour = colours[iHit];
+      fSquares.push_back( square );
     }
+  fRaster->Submit( fSquares );
 }
 
+bool
+ProjectionBase::UploadRaster()
+{
+  if( fRaster == NULL || !fRaster->Acquire( fRasterProduct ) )
+    return false;
+  // Products of the last run or image size are stale, a newer one is already submitted
+  if( fRasterProduct.fSequence <= fStaleSequence || fRasterProduct.fWidth != fImage->GetWidth() || fRasterProduct.fHeight != fImage->GetHeight() )
+    return false;
+  // Only the rows drawn over the background, now or last upload, differ from the image
+  fImage->SetPixels( &fRasterProduct.fPixels[0], fRasterProduct.fTop, fRasterProduct.fBottom );
+  fImage->Update();
+  return true;
+}
@@ -11,7 +11,19 @@
 /// \detail  All projection frame classes should just override the 
 ///          project function, which converts a 3d point into a 2d point.
 ///          The project function is pure virtual and hence this is an
-///          abstract class
+///          abstract class. The geodesic and outline are static, they are
+///          drawn into the image background once per run or colour change.
+///          If the Rendering projection configuration is gpu (and it is
+///          supported) the hits are drawn by InstancedHits instead.
+///          The projected positions are shared between frames by the
+///          ProjectionCache, until they are calculated nothing is drawn.
+///          The image matches the frame's on screen pixel size, capped
+///          by the Rendering projectionPixels configuration, and is
+///          reallocated once a resize has settled. With the GPU hits a
+///          scaling change is only a uniform update (ProcessScaling).
+///          Otherwise the hits are snapshot as pixel squares and drawn by
+///          a ProjectionRaster on the Scheduler, Render2d then uploads
+///          the newest finished pixels.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -20,12 +32,21 @@
 
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <SFML/Config.hpp>
+
+#include <utility>
+#include <vector>
 
 #include <Viewer/Frame2d.hh>
+#include <Viewer/ProjectionCache.hh>
+#include <Viewer/ProjectionRaster.hh>
 
 namespace Viewer
 {
   class ProjectionImage;
+  class InstancedHits;
 
 namespace Frames
 {
@@ -33,7 +54,8 @@ namespace Frames
 class ProjectionBase : public Frame2d
 {
 public:
-  ProjectionBase( RectPtr rect ) : Frame2d( rect ) { }
+  ProjectionBase( RectPtr rect ) : Frame2d( rect ), fProjection( NULL ), fImage( NULL ), fInstancedHits( NULL ),
+                                   fRaster( NULL ), fStaleSequence( 0 ), fBackgroundDirty( true ), fProjectionReady( false ), fPending( false ) { }
   virtual ~ProjectionBase();
 
   void Initialise( const sf::Rect<double>& size );
@@ -50,6 +72,8 @@ public:
 
   virtual void ProcessEvent( const RenderState& renderState );
 
+  virtual void ProcessScaling( const RenderState& renderState );
+
   virtual void ProcessRun();
 
   virtual void Render2d( RWWrapper& renderApp, 
@@ -59,20 +83,41 @@ public:
 		 const RenderState& renderState ) { }
 
   //EFrameType GetFrameType() { return eUtil; }
-  virtual void DrawOutline() { };
 protected:
-
-  void ProjectGeodesicLine( sf::Vector3<double> v1, 
-                            sf::Vector3<double> v2 );
-  void DrawHits( const RenderState& renderState );
+  /// Return true if the projection is calculated, on first success the background is redrawn
+  bool ProjectionReady();
+  void DrawOutline();
+  /// Snapshot the hits as pixel squares and submit them to the raster
+  void SubmitHits( const RenderState& renderState );
+  /// Upload the newest raster product if it is current, returns true if uploaded
+  bool UploadRaster();
   void DrawGeodesic();
   void DrawAllPMTs();
-
-  virtual sf::Vector2<double> Project( sf::Vector3<double> pmtPos ) = 0;
+  /// Draw the static geodesic and outline and save as the image background
+  void DrawBackground();
+  /// Return the image size in pixels to match the on screen size of the rect, capped by the configuration
+  sf::Vector2<int> GetImageSize( RectPtr rect ) const;
+  /// Resize the image if the on screen size has changed and settled, returns true if resized
+  bool CheckImageSize();
+
+  /// Return the (thread safe) projection function
+  virtual ProjectionCache::ProjectFunction GetProjectFunction() const = 0;
+  /// Return the (thread safe) outline function, NULL if no outline
+  virtual ProjectionCache::OutlineFunction GetOutlineFunction() const { return NULL; }
   
-  std::vector< sf::Vector2<double> > fProjectedPMTs; /// < Vector of projected pmt positions
-  std::vector< sf::Vector2<double> > fProjectedGeodesic; /// < Vecotr of projected geodesic positions
+  const ProjectionCache::Projection* fProjection; /// < Shared projected pmt, geodesic and outline positions
   ProjectionImage* fImage;
+  InstancedHits* fInstancedHits; /// < GPU hit renderer, NULL if hits are drawn into fImage
+  ProjectionRaster* fRaster; /// < Draws the hits into the image off thread, NULL with GPU hits
+  ProjectionRaster::Product fRasterProduct; /// < Last acquired raster product
+  std::vector<ProjectionRaster::Square> fSquares; /// < Hit squares to submit, reused
+  unsigned int fStaleSequence; /// < Raster products up to this sequence are not drawn
+  std::pair<sf::Uint32, sf::Uint32> fBackgroundColours; /// < Background and outline colours the background was drawn with
+  bool fBackgroundDirty; /// < Background requires redrawing
+  bool fProjectionReady; /// < fProjection has been calculated
+  bool fPending; /// < An event was not drawn whilst the projection was calculated
+  sf::Vector2<int> fTargetSize; /// < Image size to resize to once settled
+  sf::Clock fResizeClock; /// < Time since the target size last changed
 };
 
 } // ::Frames
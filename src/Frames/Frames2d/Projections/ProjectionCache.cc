@@ -0,0 +1,141 @@
+#include <string>
+#include <vector>
+using namespace std;
+
+#include <Viewer/ProjectionCache.hh>
+#include <Viewer/GeodesicSphere.hh>
+#include <Viewer/VBO.hh>
+#include <Viewer/FramePacer.hh>
+using namespace Viewer;
+#include <Viewer/RIDS/ChannelList.hh>
+
+const int kIndexCells = 128; // Cells are then roughly the size of a projected PMT
+
+ProjectionCache::~ProjectionCache()
+{
+  Scheduler::GetInstance().Cancel( fCalculateTask );
+  for( map< pair<string, int>, Projection* >::iterator iTer = fProjections.begin(); iTer != fProjections.end(); iTer++ )
+    delete iTer->second;
+}
+
+const ProjectionCache::Projection*
+ProjectionCache::Acquire( const string& name,
+                          int runID,
+                          const RIDS::ChannelList& channelList,
+                          ProjectFunction project,
+                          OutlineFunction outline )
+{
+  Lock lock( fLock );
+  const pair<string, int> key( name, runID );
+  map< pair<string, int>, Projection* >::iterator found = fProjections.find( key );
+  if( found != fProjections.end() )
+    {
+      found->second->fReferences++;
+      return found->second;
+    }
+
+  Projection* projection = new Projection();
+  projection->fKey = key;
+  projection->fProject = project;
+  projection->fOutlineFunction = outline;
+  projection->fReferences = 1;
+  projection->fReady = false;
+  // Copy the inputs now, neither the channel list nor the geodesic sphere are thread safe
+  projection->fPositions.reserve( channelList.GetChannelCount() );
+  for( int iChannel = 0; iChannel < channelList.GetChannelCount(); iChannel++ )
+    projection->fPositions.push_back( channelList.GetPosition( iChannel ) );
+  const VBO& geodesicVBO = GeodesicSphere::GetInstance()->OutlineVBO();
+  for( size_t iIndex = 0; iIndex + 1 < geodesicVBO.fIndices.size(); iIndex += 2 )
+    {
+      const Vertex::Data& start = geodesicVBO.fVertices[ geodesicVBO.fIndices[iIndex] ];
+      const Vertex::Data& end = geodesicVBO.fVertices[ geodesicVBO.fIndices[iIndex + 1] ];
+      projection->fGeodesicLines.push_back( sf::Vector3<double>( start.x, start.y, start.z ) );
+      projection->fGeodesicLines.push_back( sf::Vector3<double>( end.x, end.y, end.z ) );
+    }
+  fProjections[key] = projection;
+  fQueue.push_back( projection );
+  Scheduler::GetInstance().Submit( fCalculateTask );
+  return projection;
+}
+
+void
+ProjectionCache::Release( const Projection* projection )
+{
+  if( projection == NULL )
+    return;
+  Lock lock( fLock );
+  Projection* released = fProjections[projection->fKey];
+  released->fReferences--;
+  Prune( released );
+}
+
+bool
+ProjectionCache::IsReady( const Projection* projection )
+{
+  Lock lock( fLock );
+  return projection->fReady;
+}
+
+void
+ProjectionCache::CalculateQueued()
+{
+  for( ;; )
+    {
+      Projection* projection = NULL;
+      {
+        Lock lock( fLock );
+        if( fQueue.empty() )
+          return;
+        projection = fQueue.front();
+        fQueue.pop_front();
+      }
+      Calculate( *projection );
+      Lock lock( fLock );
+      projection->fReady = true;
+      Prune( projection );
+      FramePacer::GetInstance().Invalidate(); // Frames waiting on the projection can now draw
+    }
+}
+
+void
+ProjectionCache::Calculate( Projection& projection )
+{
+  ProjectBatch( projection, projection.fPositions, projection.fPMTs );
+  vector< sf::Vector3<double> >().swap( projection.fPositions );
+  projection.fPMTIndex.Build( projection.fPMTs, kIndexCells );
+
+  vector< sf::Vector3<double> > geodesic;
+  for( size_t iLine = 0; iLine + 1 < projection.fGeodesicLines.size(); iLine += 2 )
+    {
+      const sf::Vector3<double>& v1 = projection.fGeodesicLines[iLine];
+      const sf::Vector3<double> line = projection.fGeodesicLines[iLine + 1] - v1;
+      for( int iStep = 0; iStep < 30; iStep++ )
+        geodesic.push_back( v1 + line * ( static_cast<double>( iStep ) / 30.0 ) );
+    }
+  ProjectBatch( projection, geodesic, projection.fGeodesic );
+  vector< sf::Vector3<double> >().swap( projection.fGeodesicLines );
+
+  if( projection.fOutlineFunction != NULL )
+    projection.fOutlineFunction( projection.fOutline );
+}
+
+void
+ProjectionCache::ProjectBatch( const Projection& projection,
+                               const vector< sf::Vector3<double> >& positions,
+                               vector< sf::Vector2<double> >& projected )
+{
+  projected.resize( positions.size() );
+  if( positions.empty() )
+    return;
+  // sf::Vector3<double> and sf::Vector2<double> are tightly packed doubles
+  projection.fProject( &positions[0].x, positions.size(), &projected[0].x );
+}
+
+void
+ProjectionCache::Prune( Projection* projection )
+{
+  if( !projection->fReady || projection->fReferences > 0 )
+    return;
+  fProjections.erase( projection->fKey );
+  delete projection;
+}
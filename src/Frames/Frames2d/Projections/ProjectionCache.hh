@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::ProjectionCache
+///
+/// \brief   Shared, run scoped cache of projected positions
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Projections are keyed by the projection name and the run ID
+///          (which defines the channel geometry). Each projection holds
+///          the projected channel positions, geodesic and outline points
+///          and is shared, immutable, between every frame using it. The
+///          projection is calculated by a Scheduler task, frames
+///          must check IsReady before reading it. Projections are
+///          reference counted and deleted when no longer Acquired.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_ProjectionCache__
+#define __Viewer_ProjectionCache__
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
+
+#include <vector>
+#include <string>
+#include <deque>
+#include <map>
+
+#include <Viewer/Mutex.hh>
+#include <Viewer/Scheduler.hh>
+#include <Viewer/SpatialIndex.hh>
+
+namespace Viewer
+{
+namespace RIDS
+{
+  class ChannelList;
+}
+
+class ProjectionCache
+{
+public:
+  /// Project count 3d positions (xyz interleaved) into local [0,1) coords (uv interleaved), must be thread safe
+  typedef void (*ProjectFunction)( const double* xyz, size_t count, double* uv );
+  /// Fill the projection outline in local coords, must be thread safe
+  typedef void (*OutlineFunction)( std::vector< sf::Vector2<double> >& outline );
+
+  class Projection
+  {
+  public:
+    std::vector< sf::Vector2<double> > fPMTs; /// < Projected channel positions, indexed by channel id
+    std::vector< sf::Vector2<double> > fGeodesic; /// < Projected geodesic points
+    std::vector< sf::Vector2<double> > fOutline; /// < Projection outline points
+    SpatialIndex fPMTIndex; /// < Index of fPMTs, for picking
+  private:
+    friend class ProjectionCache;
+    std::pair<std::string, int> fKey; /// < Name and run ID
+    std::vector< sf::Vector3<double> > fPositions; /// < Channel positions to project, cleared once projected
+    std::vector< sf::Vector3<double> > fGeodesicLines; /// < Geodesic line start and end pairs, cleared once projected
+    ProjectFunction fProject; /// < The projection
+    OutlineFunction fOutlineFunction; /// < The outline, can be NULL
+    int fReferences; /// < Number of Acquires without a Release
+    bool fReady; /// < True once calculated
+  };
+
+  /// Singleton class instance
+  static ProjectionCache& GetInstance();
+  ~ProjectionCache();
+
+  /// Acquire the projection for the name and run, starts the calculation if not cached
+  const Projection* Acquire( const std::string& name,
+                             int runID,
+                             const RIDS::ChannelList& channelList,
+                             ProjectFunction project,
+                             OutlineFunction outline );
+  /// Release a projection returned by Acquire
+  void Release( const Projection* projection );
+  /// Return true if the projection has been calculated and can be read
+  bool IsReady( const Projection* projection );
+
+private:
+  /// Calculate the queued projections. Called by the calculate task ONLY
+  void CalculateQueued();
+  /// Calculate the projection, no lock is required as it is not yet ready
+  void Calculate( Projection& projection );
+  /// Project the positions as a single batch
+  void ProjectBatch( const Projection& projection,
+                     const std::vector< sf::Vector3<double> >& positions,
+                     std::vector< sf::Vector2<double> >& projected );
+  /// Delete the projection if ready and no longer referenced, must hold the lock
+  void Prune( Projection* projection );
+
+  std::map< std::pair<std::string, int>, Projection* > fProjections; /// < Projections by name and run ID
+  std::deque<Projection*> fQueue; /// < Projections awaiting calculation
+  Mutex fLock; /// < Guards all of the above and the projection ready state
+  MethodTask<ProjectionCache> fCalculateTask; /// < Runs CalculateQueued
+
+  /// Prevent usage of methods below, the Scheduler is created first so that it outlives the cache
+  ProjectionCache() : fCalculateTask( "ProjectionCache::Calculate", *this, &ProjectionCache::CalculateQueued ) { Scheduler::GetInstance(); }
+  ProjectionCache( ProjectionCache& );
+  void operator=( ProjectionCache& );
+};
+
+inline ProjectionCache&
+ProjectionCache::GetInstance()
+{
+  static ProjectionCache projectionCache;
+  return projectionCache;
+}
+
+} //::Viewer
+
+#endif
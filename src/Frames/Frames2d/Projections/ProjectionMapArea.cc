@@ -36,11 +36,8 @@ ProjectionMapArea::EventLoop()
       fMousePos = fMapArea->GetPosition();
       // Draw the PMT info as well?
       fPMTofInterest = -1;
-      for( unsigned int lcn = 0; lcn < fProjectedPMTs.size(); lcn++ )
-        {
-          if( fabs( fMousePos.x - fProjectedPMTs[lcn].x ) < fImage->GetSquareSize().x && fabs( fProjectedPMTs[lcn].y - fMousePos.y ) < fImage->GetSquareSize().y )
-            fPMTofInterest = lcn;
-        }
+      if( ProjectionReady() )
+        fPMTofInterest = fProjection->fPMTIndex.Nearest( fMousePos, fImage->GetSquareSize() );
       fEvents.pop();
     }
 }
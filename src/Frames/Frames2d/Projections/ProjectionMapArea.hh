@@ -41,8 +41,6 @@ public:
   virtual void Render2d( RWWrapper& renderApp,
                          const RenderState& renderState );
 protected:
-  virtual sf::Vector2<double> Project( sf::Vector3<double> pmtPos ) = 0;
-  
   GUIs::MapArea* fMapArea; /// < The map area gui
   HitInfo* fHitInfo; /// < The hit info widget
   sf::Vector2<double> fMousePos; /// < The mouse position (-1, -1) if not in frame
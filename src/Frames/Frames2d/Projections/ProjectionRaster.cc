@@ -0,0 +1,100 @@
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/ProjectionRaster.hh>
+#include <Viewer/FramePacer.hh>
+using namespace Viewer;
+
+void
+ProjectionRaster::Product::swap( Product& product )
+{
+  fPixels.swap( product.fPixels );
+  std::swap( fWidth, product.fWidth );
+  std::swap( fHeight, product.fHeight );
+  std::swap( fTop, product.fTop );
+  std::swap( fBottom, product.fBottom );
+  std::swap( fSequence, product.fSequence );
+}
+
+ProjectionRaster::~ProjectionRaster()
+{
+  Scheduler::GetInstance().Cancel( *this );
+}
+
+void
+ProjectionRaster::SetBackground( const sf::Uint32* pixels,
+                                 int width,
+                                 int height,
+                                 const sf::Vector2<int>& squareSize )
+{
+  Lock lock( fLock );
+  fInputs.fBackground.assign( pixels, pixels + width * height );
+  fInputs.fWidth = width;
+  fInputs.fHeight = height;
+  fInputs.fSquareSize = squareSize;
+  fInputs.fNewBackground = true;
+}
+
+void
+ProjectionRaster::Submit( vector<Square>& squares )
+{
+  {
+    Lock lock( fLock );
+    fInputs.fSquares.swap( squares );
+    fInputs.fSequence = ++fSequence;
+  }
+  Scheduler::GetInstance().Submit( *this );
+}
+
+void
+ProjectionRaster::Execute()
+{
+  {
+    Lock lock( fLock );
+    if( fInputs.fNewBackground )
+      {
+        fWorking.fBackground.swap( fInputs.fBackground );
+        fWorking.fWidth = fInputs.fWidth;
+        fWorking.fHeight = fInputs.fHeight;
+        fWorking.fSquareSize = fInputs.fSquareSize;
+        fInputs.fNewBackground = false;
+      }
+    fWorking.fSquares.swap( fInputs.fSquares );
+    fWorking.fSequence = fInputs.fSequence;
+  }
+  Product& product = fProducts.GetBack();
+  product.fPixels.assign( fWorking.fBackground.begin(), fWorking.fBackground.end() );
+  product.fWidth = fWorking.fWidth;
+  product.fHeight = fWorking.fHeight;
+  product.fSequence = fWorking.fSequence;
+  product.fTop = product.fBottom = 0;
+  if( product.fPixels.empty() )
+    return; // No background set yet
+  // Size is inclusive as in ProjectionImage::DrawSquare, squares are clipped to the image
+  for( vector<Square>::const_iterator iTer = fWorking.fSquares.begin(); iTer != fWorking.fSquares.end(); iTer++ )
+    {
+      const int startX = max( iTer->fX, 0 );
+      const int endX = min( iTer->fX + fWorking.fSquareSize.x + 1, product.fWidth );
+      const int startY = max( iTer->fY, 0 );
+      const int endY = min( iTer->fY + fWorking.fSquareSize.y + 1, product.fHeight );
+      if( startX >= endX || startY >= endY )
+        continue; // Entirely off the image
+      if( product.fTop == product.fBottom )
+        {
+          product.fTop = startY;
+          product.fBottom = endY;
+        }
+      else
+        {
+          product.fTop = min( product.fTop, startY );
+          product.fBottom = max( product.fBottom, endY );
+        }
+      for( int yPixel = startY; yPixel < endY; yPixel++ )
+        {
+          sf::Uint32* row = &product.fPixels[yPixel * product.fWidth];
+          fill( row + startX, row + endX, iTer->fColour );
+        }
+    }
+  fProducts.Publish();
+  FramePacer::GetInstance().Invalidate(); // The product can now be drawn
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::ProjectionRaster
+///
+/// \brief   Rasterises the projection hits on the Scheduler
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  The owning frame sets the background (a copy of the image's
+///          geodesic and outline layer) and submits the hit squares,
+///          already in pixels and packed colours. The task draws
+///          the squares over a copy of the background into the back
+///          product, noting the rows drawn, and requests a redraw. The
+///          frame acquires the finished pixels and only has to copy and
+///          upload the rows that changed.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_ProjectionRaster__
+#define __Viewer_ProjectionRaster__
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Config.hpp>
+
+#include <vector>
+
+#include <Viewer/Scheduler.hh>
+#include <Viewer/DoubleBuffer.hh>
+#include <Viewer/Mutex.hh>
+
+namespace Viewer
+{
+
+class ProjectionRaster : public Scheduler::Task
+{
+public:
+  /// A square to draw, top left in pixels
+  struct Square
+  {
+    int fX;
+    int fY;
+    sf::Uint32 fColour;
+  };
+  /// The rasterised image
+  struct Product
+  {
+    Product() : fWidth( 0 ), fHeight( 0 ), fTop( 0 ), fBottom( 0 ), fSequence( 0 ) { }
+    void swap( Product& product );
+
+    std::vector<sf::Uint32> fPixels; /// < Packed pixels, row major
+    int fWidth; /// < Width in pixels
+    int fHeight; /// < Height in pixels
+    int fTop; /// < First row drawn over the background
+    int fBottom; /// < One past the last row drawn over the background, equal to fTop if none
+    unsigned int fSequence; /// < Sequence number of the submission drawn
+  };
+
+  ProjectionRaster() : Scheduler::Task( "ProjectionRaster" ), fSequence( 0 ) { }
+  virtual ~ProjectionRaster();
+
+  /// Copy the background pixels and set the image and square size in pixels
+  void SetBackground( const sf::Uint32* pixels,
+                      int width,
+                      int height,
+                      const sf::Vector2<int>& squareSize );
+  /// Submit the squares (swapped, returned with undefined content) for rasterising
+  void Submit( std::vector<Square>& squares );
+  /// Return the sequence number of the last submission
+  unsigned int GetSequence() const { return fSequence; }
+  /// Swap the latest product into product, returns false if none is new
+  bool Acquire( Product& product ) { return fProducts.Acquire( product ); }
+
+  /// Rasterise the submitted squares, called by the Scheduler ONLY
+  virtual void Execute();
+private:
+  struct Inputs
+  {
+    Inputs() : fWidth( 0 ), fHeight( 0 ), fSequence( 0 ), fNewBackground( false ) { }
+
+    std::vector<sf::Uint32> fBackground; /// < Background pixels
+    int fWidth; /// < Image width in pixels
+    int fHeight; /// < Image height in pixels
+    sf::Vector2<int> fSquareSize; /// < Square size in pixels, inclusive
+    std::vector<Square> fSquares; /// < Squares to draw
+    unsigned int fSequence; /// < Submission sequence number
+    bool fNewBackground; /// < The background has changed since last processed
+  };
+
+  Mutex fLock; /// < Guards fInputs
+  Inputs fInputs; /// < Latest submitted inputs
+  Inputs fWorking; /// < Inputs being processed, Execute ONLY
+  DoubleBuffer<Product> fProducts; /// < Products handed to the frame
+  unsigned int fSequence; /// < Submissions made
+};
+
+} //::Viewer
+
+#endif
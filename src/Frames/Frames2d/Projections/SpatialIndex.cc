@@ -0,0 +1,114 @@
+#include <vector>
+#include <limits>
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/SpatialIndex.hh>
+using namespace Viewer;
+
+namespace
+{
+/// Return true if neither coordinate is NaN or infinite
+bool
+IsFinite( const sf::Vector2<double>& position )
+{
+  return position.x - position.x == 0.0 && position.y - position.y == 0.0;
+}
+}
+
+void
+SpatialIndex::Build( const vector< sf::Vector2<double> >& positions,
+                     int cells )
+{
+  fPositions = positions;
+  fCells = 0;
+  fCellStart.clear();
+  fIndices.clear();
+  if( cells <= 0 )
+    return;
+
+  // Non finite positions (e.g. projection singularities) are not indexed, they would poison the extent
+  size_t finite = 0;
+  sf::Vector2<double> upper;
+  for( vector< sf::Vector2<double> >::const_iterator iTer = positions.begin(); iTer != positions.end(); iTer++ )
+    {
+      if( !IsFinite( *iTer ) )
+        continue;
+      if( finite++ == 0 )
+        {
+          fMin = upper = *iTer;
+          continue;
+        }
+      fMin.x = min( fMin.x, iTer->x ); fMin.y = min( fMin.y, iTer->y );
+      upper.x = max( upper.x, iTer->x ); upper.y = max( upper.y, iTer->y );
+    }
+  if( finite == 0 )
+    return;
+  fCells = cells;
+  // Guard against a degenerate (single point or line) extent
+  fInvCellSize.x = upper.x > fMin.x ? fCells / ( upper.x - fMin.x ) : 0.0;
+  fInvCellSize.y = upper.y > fMin.y ? fCells / ( upper.y - fMin.y ) : 0.0;
+
+  // Count per cell, then prefix sum into offsets and fill (counting sort)
+  vector<int> cellIDs( positions.size(), -1 );
+  fCellStart.assign( fCells * fCells + 1, 0 );
+  for( size_t iPos = 0; iPos < positions.size(); iPos++ )
+    {
+      if( !IsFinite( positions[iPos] ) )
+        continue;
+      cellIDs[iPos] = GetCell( positions[iPos].y, fMin.y, fInvCellSize.y ) * fCells + GetCell( positions[iPos].x, fMin.x, fInvCellSize.x );
+      fCellStart[cellIDs[iPos] + 1]++;
+    }
+  for( size_t iCell = 1; iCell < fCellStart.size(); iCell++ )
+    fCellStart[iCell] += fCellStart[iCell - 1];
+  fIndices.resize( finite );
+  vector<int> next( fCellStart.begin(), fCellStart.end() - 1 );
+  for( size_t iPos = 0; iPos < positions.size(); iPos++ )
+    if( cellIDs[iPos] >= 0 )
+      fIndices[next[cellIDs[iPos]]++] = iPos;
+}
+
+int
+SpatialIndex::Nearest( const sf::Vector2<double>& position,
+                       const sf::Vector2<double>& range ) const
+{
+  if( fCells == 0 )
+    return -1;
+  const int xMin = GetCell( position.x - range.x, fMin.x, fInvCellSize.x );
+  const int xMax = GetCell( position.x + range.x, fMin.x, fInvCellSize.x );
+  const int yMin = GetCell( position.y - range.y, fMin.y, fInvCellSize.y );
+  const int yMax = GetCell( position.y + range.y, fMin.y, fInvCellSize.y );
+  int nearest = -1;
+  double nearestDist2 = numeric_limits<double>::max();
+  for( int yCell = yMin; yCell <= yMax; yCell++ )
+    for( int xCell = xMin; xCell <= xMax; xCell++ )
+      {
+        const int cell = yCell * fCells + xCell;
+        for( int iIndex = fCellStart[cell]; iIndex < fCellStart[cell + 1]; iIndex++ )
+          {
+            const sf::Vector2<double> delta = fPositions[fIndices[iIndex]] - position;
+            if( delta.x >= range.x || delta.x <= -range.x || delta.y >= range.y || delta.y <= -range.y )
+              continue;
+            const double dist2 = delta.x * delta.x + delta.y * delta.y;
+            if( dist2 < nearestDist2 )
+              {
+                nearestDist2 = dist2;
+                nearest = fIndices[iIndex];
+              }
+          }
+      }
+  return nearest;
+}
+
+int
+SpatialIndex::GetCell( double coord,
+                       double lower,
+                       double invCellSize ) const
+{
+  const double cell = ( coord - lower ) * invCellSize;
+  if( !( cell > 0.0 ) ) // Also NaN
+    return 0;
+  if( cell >= fCells - 1 )
+    return fCells - 1;
+  return static_cast<int>( cell );
+}
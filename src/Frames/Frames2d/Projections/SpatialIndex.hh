@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::SpatialIndex
+///
+/// \brief   Uniform grid index over 2d positions, for picking
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Positions are binned into a square grid spanning their
+///          bounds. Nearest only searches the cells overlapping the
+///          search range, which for picking is a handful of cells. Non
+///          finite positions are never found. The index is immutable once
+///          built.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_SpatialIndex__
+#define __Viewer_SpatialIndex__
+
+#include <SFML/System/Vector2.hpp>
+
+#include <vector>
+
+namespace Viewer
+{
+
+class SpatialIndex
+{
+public:
+  SpatialIndex() : fCells( 0 ) { }
+
+  /// Build the index over the positions, cells x cells grid
+  void Build( const std::vector< sf::Vector2<double> >& positions,
+              int cells );
+  /// Return the index of the nearest position within range (in x and y) of position, -1 if none
+  int Nearest( const sf::Vector2<double>& position,
+               const sf::Vector2<double>& range ) const;
+private:
+  /// Return the (clamped) cell column or row for the coordinate
+  int GetCell( double coord,
+               double lower,
+               double invCellSize ) const;
+
+  std::vector< sf::Vector2<double> > fPositions; /// < The indexed positions
+  std::vector<int> fCellStart; /// < Offset into fIndices per cell, plus one end offset
+  std::vector<int> fIndices; /// < Position indices ordered by cell
+  sf::Vector2<double> fMin; /// < Minimum position bound
+  sf::Vector2<double> fInvCellSize; /// < Inverse of the cell size
+  int fCells; /// < Number of cells per side, 0 if not built
+};
+
+} //::Viewer
+
+#endif
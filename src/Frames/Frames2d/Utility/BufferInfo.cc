@@ -9,6 +9,7 @@ using namespace std;
 #include <Viewer/GUIProperties.hh>
 #include <Viewer/Text.hh>
 #include <Viewer/RWWrapper.hh>
+#include <Viewer/VBO.hh>
 using namespace Viewer;
 using namespace Frames;
 #include <Viewer/RIDS/Event.hh>
@@ -28,6 +29,7 @@ BufferInfo::PreInitialise( const ConfigurationTable* configTable )
   string hello("Hello");
   fInfoText->SetString( hello );
   fInfoText->SetColour( GUIProperties::GetInstance().GetGUIColourPalette().GetB( eBase ) );
+  fBufferElements = static_cast<size_t>( -1 ); // Forces the first build
 }
 
 void 
@@ -42,18 +44,31 @@ void
 BufferInfo::Render2d( RWWrapper& renderApp,
 		     const RenderState& renderState )
 {
-  stringstream eventInfo;
-  eventInfo.precision( 0 );
-  eventInfo << fixed;
-  eventInfo << "Input Buffer:" << endl;
-  eventInfo << "\tSize:" << DataStore::GetInstance().GetInputBufferSize() << endl;
-  eventInfo << "\tWaiting elements:" << DataStore::GetInstance().GetBufferElements() << endl;
+  const DataStore& dataStore = DataStore::GetInstance();
+  if( dataStore.GetBufferElements() != fBufferElements || dataStore.GetEventsAdded() != fEventsAdded ||
+      VBO::GetFrameUploadBytes() != fUploadBytes || VBO::GetFrameDrawCalls() != fDrawCalls )
+    {
+      fBufferElements = dataStore.GetBufferElements();
+      fEventsAdded = dataStore.GetEventsAdded();
+      fUploadBytes = VBO::GetFrameUploadBytes();
+      fDrawCalls = VBO::GetFrameDrawCalls();
+      stringstream eventInfo;
+      eventInfo.precision( 0 );
+      eventInfo << fixed;
+      eventInfo << "Input Buffer:" << endl;
+      eventInfo << "\tSize:" << dataStore.GetInputBufferSize() << endl;
+      eventInfo << "\tWaiting elements:" << fBufferElements << endl;
+
+      eventInfo << "Buffer:" << endl;
+      eventInfo << "\tSize:" << dataStore.GetBufferSize() << endl;
+      eventInfo << "\tEvents Added:" << fEventsAdded << endl;
 
-  eventInfo << "Buffer:" << endl;
-  eventInfo << "\tSize:" << DataStore::GetInstance().GetBufferSize() << endl;
-  eventInfo << "\tEvents Added:" << DataStore::GetInstance().GetEventsAdded() << endl;
+      eventInfo << "GPU:" << endl;
+      eventInfo << "\tVBO upload (bytes/frame):" << fUploadBytes << endl;
+      eventInfo << "\tVBO draw calls (per frame):" << fDrawCalls << endl;
 
-  fInfoText->SetString( eventInfo.str() );
+      fInfoText->SetString( eventInfo.str() );
+    }
   fInfoText->SetColour( GUIProperties::GetInstance().GetGUIColourPalette().GetText() );
   renderApp.Draw( *fInfoText );  
 }
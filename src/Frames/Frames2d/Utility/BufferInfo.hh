@@ -8,7 +8,8 @@
 /// REVISION HISTORY:\n
 ///     27/10/11 : P.Jones - First Revision, new file. \n
 ///
-/// \detail  Displays information about the buffers.
+/// \detail  Displays information about the buffers, including the GPU
+///          (VBO) upload and draw calls per frame.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -29,7 +30,7 @@ namespace Frames
 class BufferInfo : public Frame2d
 {
 public:
-  BufferInfo( RectPtr rect ) : Frame2d( rect ) { }
+  BufferInfo( RectPtr rect ) : Frame2d( rect ), fBufferElements( 0 ), fEventsAdded( 0 ), fUploadBytes( 0 ), fDrawCalls( 0 ) { }
   ~BufferInfo();
 
   /// Initialise without using the DataStore
@@ -59,6 +60,10 @@ public:
   static std::string ToHexString( int number );
 private:
   Text* fInfoText;
+  size_t fBufferElements; /// < Input buffer elements shown in fInfoText
+  size_t fEventsAdded; /// < Events added shown in fInfoText
+  size_t fUploadBytes; /// < VBO upload bytes shown in fInfoText
+  size_t fDrawCalls; /// < VBO draw calls shown in fInfoText
 };
 
 } // ::Frames
@@ -0,0 +1,77 @@
+#include <SFML/Graphics/Rect.hpp>
+
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include <Viewer/ProfilerInfo.hh>
+#include <Viewer/Profiler.hh>
+#include <Viewer/GUIProperties.hh>
+#include <Viewer/Text.hh>
+#include <Viewer/RWWrapper.hh>
+#include <Viewer/FramePacer.hh>
+using namespace Viewer;
+using namespace Frames;
+
+const double kWindow = 5.0; // Seconds of records summarised
+const double kRefreshPeriod = 0.5; // Seconds between text refreshes
+const size_t kMaxLines = 20; // Stages shown
+
+ProfilerInfo::~ProfilerInfo()
+{
+  delete fInfoText;
+}
+
+void 
+ProfilerInfo::PreInitialise( const ConfigurationTable* configTable )
+{
+  sf::Rect<double> textSize;
+  textSize.left = 0.05; textSize.top = 0.0; textSize.width = 0.95; textSize.height = 1.0;
+  fInfoText = new Text( RectPtr( fRect->NewDaughter( textSize, Rect::eLocal ) ) );
+  fInfoText->SetColour( GUIProperties::GetInstance().GetGUIColourPalette().GetText() );
+}
+
+void 
+ProfilerInfo::EventLoop()
+{
+  while( !fEvents.empty() )
+    {
+      fEvents.pop();
+    }
+}
+
+void 
+ProfilerInfo::Render2d( RWWrapper& renderApp,
+                        const RenderState& renderState )
+{
+  if( fRefresh || fRefreshClock.getElapsedTime().asSeconds() >= kRefreshPeriod )
+    {
+      fRefresh = false;
+      fRefreshClock.restart();
+      vector<Profiler::Stat> stats;
+      Profiler::GetInstance().GetStats( kWindow, stats );
+      stringstream info;
+      info << fixed << setprecision( 2 );
+      info << "Last " << kWindow << "s, median/p95/max ms, count:" << endl;
+      for( size_t iStat = 0; iStat < stats.size() && iStat < kMaxLines; iStat++ )
+        {
+          const Profiler::Stat& stat = stats[iStat];
+          info << stat.fName << "  " << stat.fMedian * 1.0e3 << "/" << stat.fP95 * 1.0e3 << "/" << stat.fMax * 1.0e3
+               << "  " << stat.fCount << endl;
+        }
+      vector<Profiler::Counter> counters;
+      Profiler::GetInstance().GetCounters( kWindow, counters );
+      if( !counters.empty() )
+        info << "Counters, last/mean/max:" << endl;
+      for( vector<Profiler::Counter>::const_iterator iTer = counters.begin(); iTer != counters.end(); iTer++ )
+        info << iTer->fName << "  " << iTer->fLast << "/" << iTer->fMean << "/" << iTer->fMax << endl;
+      info << "Press P to save a Chrome trace" << endl;
+      fInfoText->SetString( info.str() );
+    }
+  // Keep refreshing whilst shown, even if nothing else is redrawing
+  FramePacer::GetInstance().InvalidateIn( kRefreshPeriod - fRefreshClock.getElapsedTime().asSeconds() );
+  fInfoText->SetColour( GUIProperties::GetInstance().GetGUIColourPalette().GetText() );
+  renderApp.Draw( *fInfoText );
+}
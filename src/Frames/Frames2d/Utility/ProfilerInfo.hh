@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::Frames::ProfilerInfo
+///
+/// \brief   ProfilerInfo frame, displays where the frame time goes
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Displays the Profiler's stage timings over the last few
+///          seconds, per stage the median, 95th percentile and maximum
+///          duration. The largest total times are listed first, followed
+///          by the counters (e.g. VBO draw calls per frame). The text is
+///          refreshed periodically. Pressing P saves a Chrome trace.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_Frames_ProfilerInfo__
+#define __Viewer_Frames_ProfilerInfo__
+
+#include <SFML/System/Clock.hpp>
+
+#include <string>
+
+#include <Viewer/Frame2d.hh>
+
+namespace Viewer
+{
+  class Text;
+
+namespace Frames
+{
+
+class ProfilerInfo : public Frame2d
+{
+public:
+  ProfilerInfo( RectPtr rect ) : Frame2d( rect ), fInfoText( NULL ), fRefresh( true ) { }
+  ~ProfilerInfo();
+
+  /// Initialise without using the DataStore
+  void PreInitialise( const ConfigurationTable* configTable );
+  /// Initilaise with DataStore access
+  void PostInitialise( const ConfigurationTable* configTable ) { };
+  /// Save the configuration
+  void SaveConfiguration( ConfigurationTable* configTable ) { };
+ 
+  virtual void EventLoop();
+  
+  virtual std::string GetName() { return ProfilerInfo::Name(); }
+  
+  static std::string Name() { return std::string( "Profiler" ); }
+
+  virtual void ProcessEvent( const RenderState& renderState ) { }
+
+  virtual void ProcessRun() { } 
+
+  virtual void Render2d( RWWrapper& windowApp,
+                         const RenderState& renderState );
+  
+  void Render3d( RWWrapper& windowApp,
+                 const RenderState& renderState ) { }
+private:
+  Text* fInfoText; /// < The timings
+  sf::Clock fRefreshClock; /// < Time since the text was last refreshed
+  bool fRefresh; /// < Refresh on the next render
+};
+
+} // ::Frames
+
+} // ::Viewer
+
+#endif
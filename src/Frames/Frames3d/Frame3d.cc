@@ -1,6 +1,7 @@
 #include <Viewer/Frame3d.hh>
 #include <Viewer/Module3d.hh>
 #include <Viewer/Camera3d.hh>
+#include <Viewer/GUIProperties.hh>
 using namespace Viewer;
 
 Module3dFactory Frame3d::fsModule3dFactory;
@@ -64,6 +65,17 @@ Frame3d::ProcessEvent( const RenderState& renderState )
   for( vector<Module3d*>::iterator iTer = fModules.begin(); iTer != fModules.end(); iTer++ )
     (*iTer)->ProcessEvent( renderState );
   fCamera->ProcessEvent( renderState );
+  if( GUIProperties::GetInstance().HasChanged() )
+    BuildStatic(); // Colours may have changed
+}
+
+void 
+Frame3d::ProcessScaling( const RenderState& renderState )
+{
+  for( vector<Module3d*>::iterator iTer = fModules.begin(); iTer != fModules.end(); iTer++ )
+    (*iTer)->ProcessScaling( renderState );
+  if( GUIProperties::GetInstance().HasChanged() )
+    BuildStatic();
 }
 
 void 
@@ -72,6 +84,7 @@ Frame3d::ProcessRun()
   for( vector<Module3d*>::iterator iTer = fModules.begin(); iTer != fModules.end(); iTer++ )
     (*iTer)->ProcessRun();
   fCamera->ProcessRun();
+  BuildStatic();
 }
 
 void 
@@ -79,8 +92,10 @@ Frame3d::Render3d( RWWrapper& renderApp,
                    const RenderState& )
 {
   fCamera->SetGLCamera();
+  fStaticScene.RenderDepth();
   for( vector<Module3d*>::iterator iTer = fModules.begin(); iTer != fModules.end(); iTer++ )
     (*iTer)->Render3d();
+  fStaticScene.RenderOverlay();
   fCamera->Render3d();
 }
 
@@ -93,6 +108,15 @@ Frame3d::RenderGUI( RWWrapper& renderApp,
   fCamera->RenderGUI( renderApp );
 }
 
+void
+Frame3d::BuildStatic()
+{
+  fStaticScene.Clear();
+  for( vector<Module3d*>::iterator iTer = fModules.begin(); iTer != fModules.end(); iTer++ )
+    (*iTer)->BuildStatic( fStaticScene );
+  fStaticScene.Bind();
+}
+
 void 
 Frame3d::SetCamera( const std::string& cameraName,
                     const sf::Rect<double>& cameraSize )
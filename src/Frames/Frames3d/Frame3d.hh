@@ -9,7 +9,9 @@
 ///     06/04/13 : P.Jones - New file, first revision \n
 ///
 /// \detail  All 3d frames derive from this, adds the standard 3d 
-///          management system.
+///          management system. The modules' static geometry is built
+///          into a single StaticScene per run (or colour change) and
+///          drawn with a call per draw state.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -23,6 +25,7 @@
 
 #include <Viewer/Frame.hh>
 #include <Viewer/Module3dFactory.hh>
+#include <Viewer/StaticScene.hh>
 
 namespace Viewer
 {
@@ -45,6 +48,8 @@ public:
   virtual void PostInitialise( const ConfigurationTable* configTable );
   /// Process event data
   virtual void ProcessEvent( const RenderState& renderState );
+  /// Process a scaling or colour change only, the camera is unaffected
+  virtual void ProcessScaling( const RenderState& renderState );
   /// Process run data
   virtual void ProcessRun();
   /// Render all 2d objects
@@ -64,6 +69,10 @@ protected:
   void AddModule( const std::string& moduleName,
                   const sf::Rect<double>& guiSize );
 private:
+  /// Rebuild the static scene from the modules
+  void BuildStatic();
+
+  StaticScene fStaticScene; /// < The modules' static geometry
   Camera3d* fCamera; /// < Must have a camera module
   std::vector<Module3d*> fModules; /// < The 3d Modules
 
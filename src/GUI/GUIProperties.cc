@@ -9,6 +9,7 @@ using namespace Viewer;
 GUIProperties::GUIProperties()
 {
   fChanged = true;
+  fRevision = 1;
 }
 
 GUIProperties::~GUIProperties()
@@ -60,6 +60,8 @@ public:
 
   inline void Reset();
   inline bool HasChanged() const;
+  /// Return the number of changes so far, unlike HasChanged this is never reset
+  inline unsigned int GetRevision() const;
 private:
   GUIProperties();
 
@@ -68,6 +70,7 @@ private:
   ColourPalette fColourPalette; /// < The general colour palette
   ConfigurationFile* fGUIConfiguration; /// < The stored gui configuration xml data
   bool fChanged; /// < Has the gui changed in the last frame
+  unsigned int fRevision; /// < Number of changes so far
 
   /// Stop usage of
   GUIProperties( GUIProperties const& );
@@ -85,6 +88,7 @@ inline void
 GUIProperties::LoadGUIColourPalette( const std::string& filename )
 {
   fChanged = true;
+  fRevision++;
   fGUIColourPalette.Load( filename );
 }
 
@@ -92,6 +96,7 @@ inline void
 GUIProperties::LoadColourPalette( const std::string& filename )
 {
   fChanged = true;
+  fRevision++;
   fColourPalette.Load( filename );
 }
 
@@ -99,6 +104,7 @@ inline void
 GUIProperties::InvertGUI()
 {
   fChanged = true;
+  fRevision++;
   fGUIColourPalette.Invert();
 }
 
@@ -126,6 +132,12 @@ GUIProperties::HasChanged() const
   return fChanged;
 }
 
+inline unsigned int
+GUIProperties::GetRevision() const
+{
+  return fRevision;
+}
+
 inline void
 GUIProperties::Reset()
 {
@@ -8,6 +8,7 @@ using namespace std;
 #include <Viewer/GUIProperties.hh>
 #include <Viewer/Sprite.hh>
 #include <Viewer/RWWrapper.hh>
+#include <Viewer/FramePacer.hh>
 using namespace Viewer;
 using namespace Viewer::GUIs;
 
@@ -175,6 +176,8 @@ TextBox::Render( RWWrapper& renderApp )
       fClock.restart();
       fBlink = !fBlink;
     }
+  if( fsKeyboardFocus == static_cast<int>( fGlobalID ) )
+    FramePacer::GetInstance().InvalidateIn( 0.5 - fClock.getElapsedTime().asSeconds() ); // Blink the cursor
   if( fText.isEmpty() && fBlink )
     renderApp.Draw( cursor );
   renderApp.Draw( *fDrawnText );
@@ -11,6 +11,9 @@ MapArea::NewEvent( const Event& event )
   GUIEvent ret; // NULL event
   switch( event.type )
     {
+    case sf::Event::MouseButtonReleased:
+      fClicked = true;
+      // Fall through and update the position
     case sf::Event::MouseMoved:
       {
         sf::Vector2<double> resPos = event.GetPos();
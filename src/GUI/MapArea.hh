@@ -35,15 +35,18 @@ public:
   virtual GUIEvent NewEvent( const Event& event );
 
   inline sf::Vector2<double> GetPosition();
+  /// Return true if clicked since the last call
+  inline bool GetClicked();
 protected:
   sf::Vector2<double> fCurrentPos;
+  bool fClicked; /// < True if clicked and not yet queried
 };
 
 inline
 MapArea::MapArea( RectPtr rect, unsigned int guiID ) 
   : GUI( rect, guiID ) 
 { 
-
+  fClicked = false;
 }
 
 inline sf::Vector2<double>
@@ -52,6 +55,14 @@ MapArea::GetPosition()
   return fCurrentPos;
 }
 
+inline bool
+MapArea::GetClicked()
+{
+  const bool clicked = fClicked;
+  fClicked = false;
+  return clicked;
+}
+
 } // ::GUIs
 
 } // ::Viewer
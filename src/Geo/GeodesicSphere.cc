@@ -57,4 +57,9 @@ const VBO& GeodesicSphere::OutlineVBO() const
     return fOutlineVBO;
 }
 
+const VBO& GeodesicSphere::FullVBO() const 
+{
+    return fFullVBO;
+}
+
 }; // namespace Viewer
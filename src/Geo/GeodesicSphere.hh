@@ -33,6 +33,7 @@ public:
 	const Polyhedron& GetPolyhedron();
     void Render() const;
     const VBO& OutlineVBO() const;
+    const VBO& FullVBO() const;
 private:
 	Polyhedron* fPolyhedron;
     VBO fOutlineVBO;
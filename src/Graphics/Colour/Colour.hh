@@ -22,6 +22,8 @@
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Config.hpp>
 
+#include <cstring>
+
 #include <Viewer/Serializable.hh>
 
 namespace Viewer
@@ -39,6 +41,8 @@ public:
 
   inline void SetOpenGL() const;
   inline void ClearOpenGL() const;
+  /// Return the colour packed into a word, RGBA byte order in memory
+  inline sf::Uint32 GetPacked() const;
 
   void AddColourFraction( const Colour& newColour, 
                           const double fraction );
@@ -67,6 +71,15 @@ Colour::SetOpenGL() const
 	     static_cast<float>( a ) / 255.0f );
 }
 
+sf::Uint32
+Colour::GetPacked() const
+{
+  const sf::Uint8 bytes[4] = { r, g, b, a };
+  sf::Uint32 word;
+  memcpy( &word, bytes, sizeof( word ) );
+  return word;
+}
+
 } // ::Viewer
 
 #endif
@@ -37,6 +37,7 @@ ColourPalette::Load( const std::string& fileName )
       const ConfigurationTable* configTable = stopTable->GetTable( tableName.str() );
       fColourStops.push_back( pair< double, Colour >( configTable->GetD( "value" ), Colour( configTable ) ) );
     }
+  BuildLUT();
 }
 
 Colour
@@ -51,3 +52,11 @@ ColourPalette::GetColour( double value ) const
   result.AddColourFraction( fColourStops[uStop].second, regionFraction );
   return result;
 }
+
+void
+ColourPalette::BuildLUT()
+{
+  fLUT.resize( kLUTSize );
+  for( int iEntry = 0; iEntry < kLUTSize; iEntry++ )
+    fLUT[iEntry] = GetColour( static_cast<double>( iEntry ) / static_cast<double>( kLUTSize - 1 ) ).GetPacked();
+}
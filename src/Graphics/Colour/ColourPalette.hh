@@ -10,7 +10,8 @@
 ///     28/05/12 : P.Jones - Second Revision, refactor now loaded.\n
 ///
 /// \detail  Colour palettes are loaded from xml files and accessed via
-///          this class. 
+///          this class. On load a lookup table of packed colours is built,
+///          use this when colouring many values.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -21,6 +22,8 @@
 #include <map>
 #include <vector>
 
+#include <SFML/Config.hpp>
+
 #include <Viewer/Colour.hh>
 
 namespace Viewer
@@ -34,18 +37,38 @@ public:
   ColourPalette();
 
   enum EScalingMode { eContinuous, eDiscrete };
+  static const int kLUTSize = 1024; /// < Number of entries in the lookup table
   /// Load a colour palette given a fileName
   void Load( const std::string& fileName );
   /// Get the colour given a value [0,1]
   Colour GetColour( double value ) const ;
+  /// Get the packed colour given a value [0,1] (clamped) from the lookup table
+  inline sf::Uint32 GetPackedColour( double value ) const;
+  /// Return the lookup table, kLUTSize packed colours evenly spaced over [0,1]
+  const std::vector<sf::Uint32>& GetLUT() const { return fLUT; }
   /// Get a primary colour
   inline Colour GetPrimaryColour( EColour value ) const;
 private:
+  /// Build the lookup table from the colour stops
+  void BuildLUT();
+
   std::map<EColour, Colour> fPrimaryColours; /// < The primary colours mapping
   std::vector< std::pair< double, Colour > > fColourStops; /// < The colour stop values and colours, in order
+  std::vector<sf::Uint32> fLUT; /// < Packed colour lookup table
   EScalingMode fMode;
 };
 
+inline sf::Uint32
+ColourPalette::GetPackedColour( double value ) const
+{
+  int index = static_cast<int>( value * ( kLUTSize - 1 ) + 0.5 );
+  if( index < 0 )
+    index = 0;
+  else if( index >= kLUTSize )
+    index = kLUTSize - 1;
+  return fLUT[index];
+}
+
 inline Colour 
 ColourPalette::GetPrimaryColour( EColour value ) const
 {
@@ -0,0 +1,165 @@
+#define GL_GLEXT_PROTOTYPES
+
+#include <SFML/OpenGL.hpp>
+
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/InstancedHits.hh>
+#include <Viewer/RenderState.hh>
+#include <Viewer/Rect.hh>
+using namespace Viewer;
+#include <Viewer/RIDS/Channel.hh>
+
+const char* kVertexShader =
+  "#version 120\n"
+  "attribute vec2 corner;\n" // Unit quad corner
+  "attribute vec2 position;\n" // Per instance projected position
+  "attribute float value;\n" // Per instance value, zero is no hit
+  "uniform vec2 squareSize;\n"
+  "uniform vec2 scaling;\n" // min, max
+  "varying float fraction;\n"
+  "void main()\n"
+  "{\n"
+  "  fraction = ( value - scaling.x ) / max( scaling.y - scaling.x, 1.0e-6 );\n"
+  "  if( value == 0.0 )\n"
+  "    gl_Position = vec4( 2.0, 2.0, 2.0, 1.0 );\n" // Outside the clip volume, culled
+  "  else\n"
+  "    gl_Position = gl_ModelViewProjectionMatrix * vec4( position + corner * squareSize, 0.0, 1.0 );\n"
+  "}\n";
+
+InstancedHits::InstancedHits( RectPtr rect )
+  : fRect( rect ), fCornerVBOID( 0 ), fPositionVBOID( 0 ), fValueVBOID( 0 )
+{
+  fProgram = BuildProgram();
+  if( fProgram == 0 )
+    return;
+  fCornerLocation = glGetAttribLocation( fProgram, "corner" );
+  fPositionLocation = glGetAttribLocation( fProgram, "position" );
+  fValueLocation = glGetAttribLocation( fProgram, "value" );
+
+  const GLfloat corners[8] = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f }; // Triangle strip order
+  glGenBuffers( 1, &fCornerVBOID );
+  glBindBuffer( GL_ARRAY_BUFFER, fCornerVBOID );
+  glBufferData( GL_ARRAY_BUFFER, sizeof( corners ), corners, GL_STATIC_DRAW );
+  glGenBuffers( 1, &fPositionVBOID );
+  glGenBuffers( 1, &fValueVBOID );
+  glBindBuffer( GL_ARRAY_BUFFER, 0 );
+  fPalette.Create();
+}
+
+InstancedHits::~InstancedHits()
+{
+  if( fProgram == 0 )
+    return;
+  glDeleteBuffers( 1, &fCornerVBOID );
+  glDeleteBuffers( 1, &fPositionVBOID );
+  glDeleteBuffers( 1, &fValueVBOID );
+  fPalette.Destroy();
+  glDeleteProgram( fProgram );
+}
+
+void
+InstancedHits::SetPositions( const vector< sf::Vector2<double> >& positions )
+{
+  fValues.assign( positions.size(), 0.0f );
+  if( fProgram == 0 || positions.empty() )
+    return;
+  vector<GLfloat> packed( positions.size() * 2 );
+  for( size_t iPosition = 0; iPosition < positions.size(); iPosition++ )
+    {
+      packed[iPosition * 2] = static_cast<GLfloat>( positions[iPosition].x );
+      packed[iPosition * 2 + 1] = static_cast<GLfloat>( positions[iPosition].y );
+    }
+  glBindBuffer( GL_ARRAY_BUFFER, fPositionVBOID );
+  glBufferData( GL_ARRAY_BUFFER, packed.size() * sizeof( GLfloat ), &packed[0], GL_STATIC_DRAW );
+  // Allocate the value storage now, per event it is only updated
+  glBindBuffer( GL_ARRAY_BUFFER, fValueVBOID );
+  glBufferData( GL_ARRAY_BUFFER, fValues.size() * sizeof( GLfloat ), &fValues[0], GL_STREAM_DRAW );
+  glBindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+void
+InstancedHits::SetHits( const vector<RIDS::Channel>& hits,
+                        const RenderState& renderState )
+{
+  if( fProgram == 0 || fValues.empty() )
+    return;
+  fill( fValues.begin(), fValues.end(), 0.0f );
+  for( vector<RIDS::Channel>::const_iterator iTer = hits.begin(); iTer != hits.end(); iTer++ )
+    if( iTer->GetID() >= 0 && iTer->GetID() < static_cast<int>( fValues.size() ) )
+      fValues[iTer->GetID()] = static_cast<float>( iTer->GetData() );
+  glBindBuffer( GL_ARRAY_BUFFER, fValueVBOID );
+  glBufferSubData( GL_ARRAY_BUFFER, 0, fValues.size() * sizeof( GLfloat ), &fValues[0] );
+  glBindBuffer( GL_ARRAY_BUFFER, 0 );
+  SetScaling( renderState );
+}
+
+void
+InstancedHits::SetScaling( const RenderState& renderState )
+{
+  if( fProgram == 0 )
+    return;
+  fScaling = sf::Vector2<double>( renderState.GetScalingMin(), renderState.GetScalingMax() );
+  fPalette.Update();
+}
+
+void
+InstancedHits::Render()
+{
+  if( fProgram == 0 || fValues.empty() )
+    return;
+  const sf::Rect<double> rect = fRect->GetRect( Rect::eGL );
+  glViewport( static_cast<GLint>( rect.left ),
+              static_cast<GLint>( rect.top ),
+              static_cast<GLsizei>( rect.width ),
+              static_cast<GLsizei>( rect.height ) );
+  glMatrixMode( GL_PROJECTION );
+  glLoadIdentity();
+  glOrtho( 0.0, 1.0, 1.0, 0.0, -1.0, 1.0 ); // Local coords, y down
+  glMatrixMode( GL_MODELVIEW );
+  glLoadIdentity();
+  glDisable( GL_DEPTH_TEST );
+  glDisable( GL_BLEND );
+
+  glUseProgram( fProgram );
+  glUniform2f( glGetUniformLocation( fProgram, "squareSize" ), fSquareSize.x, fSquareSize.y );
+  glUniform2f( glGetUniformLocation( fProgram, "scaling" ), fScaling.x, fScaling.y );
+  fPalette.Bind( fProgram );
+
+  glBindBuffer( GL_ARRAY_BUFFER, fCornerVBOID );
+  glEnableVertexAttribArray( fCornerLocation );
+  glVertexAttribPointer( fCornerLocation, 2, GL_FLOAT, GL_FALSE, 0, 0 );
+  glBindBuffer( GL_ARRAY_BUFFER, fPositionVBOID );
+  glEnableVertexAttribArray( fPositionLocation );
+  glVertexAttribPointer( fPositionLocation, 2, GL_FLOAT, GL_FALSE, 0, 0 );
+  glVertexAttribDivisorARB( fPositionLocation, 1 );
+  glBindBuffer( GL_ARRAY_BUFFER, fValueVBOID );
+  glEnableVertexAttribArray( fValueLocation );
+  glVertexAttribPointer( fValueLocation, 1, GL_FLOAT, GL_FALSE, 0, 0 );
+  glVertexAttribDivisorARB( fValueLocation, 1 );
+
+  glDrawArraysInstancedARB( GL_TRIANGLE_STRIP, 0, 4, fValues.size() );
+
+  glVertexAttribDivisorARB( fPositionLocation, 0 );
+  glVertexAttribDivisorARB( fValueLocation, 0 );
+  glDisableVertexAttribArray( fCornerLocation );
+  glDisableVertexAttribArray( fPositionLocation );
+  glDisableVertexAttribArray( fValueLocation );
+  glBindBuffer( GL_ARRAY_BUFFER, 0 );
+  fPalette.Release();
+  glUseProgram( 0 );
+}
+
+GLuint
+InstancedHits::BuildProgram()
+{
+  const char* extensions = reinterpret_cast<const char*>( glGetString( GL_EXTENSIONS ) );
+  const char* version = reinterpret_cast<const char*>( glGetString( GL_VERSION ) );
+  if( extensions == NULL || version == NULL || atoi( version ) < 2 ||
+      strstr( extensions, "GL_ARB_instanced_arrays" ) == NULL )
+    return 0;
+  return PaletteShader::BuildProgram( "InstancedHits", kVertexShader, PaletteShader::kFragmentShader, NULL );
+}
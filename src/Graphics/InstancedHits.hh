@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::InstancedHits
+///
+/// \brief   Draws projected hits as instanced quads on the GPU
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  The projected channel positions are uploaded once per run,
+///          per event only a single float per channel is uploaded. Each
+///          channel is drawn as a quad instance, zero values are culled
+///          and the palette lookup is made in the fragment shader from a
+///          PaletteShader texture, uploaded only when the colours change. Requires GL_ARB_instanced_arrays and GLSL
+///          1.20, check IsValid after construction.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_InstancedHits__
+#define __Viewer_InstancedHits__
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/OpenGL.hpp>
+
+#include <vector>
+
+#include <Viewer/RectPtr.hh>
+#include <Viewer/PaletteShader.hh>
+
+namespace Viewer
+{
+  class RenderState;
+namespace RIDS
+{
+  class Channel;
+}
+
+class InstancedHits
+{
+public:
+  /// Construct with the rect to render into, compiles the shaders
+  InstancedHits( RectPtr rect );
+  ~InstancedHits();
+
+  /// Return true if the GPU supports this and the shaders compiled
+  bool IsValid() const { return fProgram != 0; }
+  /// Set the projected channel positions (local coords), call once per run
+  void SetPositions( const std::vector< sf::Vector2<double> >& positions );
+  /// Set the hit data, the scaling and palette from the render state
+  void SetHits( const std::vector<RIDS::Channel>& hits,
+                const RenderState& renderState );
+  /// Set only the scaling and palette from the render state, no upload unless the palette changed
+  void SetScaling( const RenderState& renderState );
+  /// Set the quad size in local coords
+  void SetSquareSize( const sf::Vector2<double>& size ) { fSquareSize = size; }
+  /// Render the hits, GL state is not preserved (see RWWrapper::Draw)
+  void Render();
+  /// Return the local Rect
+  RectPtr GetRect() const { return fRect; }
+private:
+  /// Compile and link the shader program, returns 0 on failure or if not supported
+  GLuint BuildProgram();
+
+  RectPtr fRect; /// < The rect to render into
+  std::vector<float> fValues; /// < Value per channel, zero is no hit
+  PaletteShader fPalette; /// < Palette texture
+  sf::Vector2<double> fSquareSize; /// < Quad size in local coords
+  sf::Vector2<double> fScaling; /// < Data scaling min, max
+  GLuint fProgram; /// < Shader program, 0 if not supported
+  GLuint fCornerVBOID; /// < Unit quad corners
+  GLuint fPositionVBOID; /// < Per instance position
+  GLuint fValueVBOID; /// < Per instance value
+  GLint fCornerLocation; /// < Shader attribute locations
+  GLint fPositionLocation;
+  GLint fValueLocation;
+};
+
+} // ::Viewer
+
+#endif
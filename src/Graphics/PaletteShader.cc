@@ -0,0 +1,121 @@
+#define GL_GLEXT_PROTOTYPES
+
+#include <SFML/OpenGL.hpp>
+
+#include <cstring>
+#include <vector>
+#include <iostream>
+using namespace std;
+
+#include <Viewer/PaletteShader.hh>
+#include <Viewer/PixelImage.hh>
+#include <Viewer/GUIProperties.hh>
+using namespace Viewer;
+
+const char* PaletteShader::kFragmentShader =
+  "#version 120\n"
+  "uniform sampler1D palette;\n"
+  "uniform vec4 background;\n"
+  "varying float fraction;\n"
+  "void main()\n"
+  "{\n"
+  "  if( fraction < 0.0 || fraction > 1.0 )\n"
+  "    gl_FragColor = background;\n"
+  "  else\n"
+  "    gl_FragColor = texture1D( palette, fraction );\n"
+  "}\n";
+
+GLuint
+PaletteShader::BuildProgram( const char* owner,
+                             const char* vertexSource,
+                             const char* fragmentSource,
+                             const char* const* attributes )
+{
+  const char* sources[2] = { vertexSource, fragmentSource };
+  const GLenum types[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+  GLuint program = glCreateProgram();
+  for( int iShader = 0; iShader < 2; iShader++ )
+    {
+      GLuint shader = glCreateShader( types[iShader] );
+      glShaderSource( shader, 1, &sources[iShader], NULL );
+      glCompileShader( shader );
+      GLint status;
+      glGetShaderiv( shader, GL_COMPILE_STATUS, &status );
+      if( status == GL_FALSE )
+        {
+          char log[1024];
+          glGetShaderInfoLog( shader, sizeof( log ), NULL, log );
+          cerr << owner << " shader failed to compile: " << log << endl;
+          glDeleteShader( shader );
+          glDeleteProgram( program );
+          return 0;
+        }
+      glAttachShader( program, shader );
+      glDeleteShader( shader ); // Deleted when the program is
+    }
+  for( GLuint iAttribute = 0; attributes != NULL && attributes[iAttribute] != NULL; iAttribute++ )
+    glBindAttribLocation( program, iAttribute, attributes[iAttribute] );
+  glLinkProgram( program );
+  GLint status;
+  glGetProgramiv( program, GL_LINK_STATUS, &status );
+  if( status == GL_FALSE )
+    {
+      cerr << owner << " shader program failed to link." << endl;
+      glDeleteProgram( program );
+      return 0;
+    }
+  return program;
+}
+
+void
+PaletteShader::Create()
+{
+  glGenTextures( 1, &fTexture );
+  glBindTexture( GL_TEXTURE_1D, fTexture );
+  glTexParameteri( GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+  glTexParameteri( GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+  glTexParameteri( GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+  glBindTexture( GL_TEXTURE_1D, 0 );
+  fRevision = 0;
+}
+
+void
+PaletteShader::Destroy()
+{
+  if( fTexture != 0 )
+    glDeleteTextures( 1, &fTexture );
+  fTexture = 0;
+}
+
+void
+PaletteShader::Update()
+{
+  const GUIProperties& guiProperties = GUIProperties::GetInstance();
+  if( fTexture == 0 || fRevision == guiProperties.GetRevision() )
+    return;
+  fRevision = guiProperties.GetRevision();
+  fBackground = PixelImage::PackColour( guiProperties.GetGUIColourPalette().GetBackground() );
+  // The lookup table is already packed RGBA, evenly spaced over [0, 1]
+  const vector<sf::Uint32>& lut = guiProperties.GetColourPalette().GetLUT();
+  glBindTexture( GL_TEXTURE_1D, fTexture );
+  glTexImage1D( GL_TEXTURE_1D, 0, GL_RGBA, lut.size(), 0, GL_RGBA, GL_UNSIGNED_BYTE, &lut[0] );
+  glBindTexture( GL_TEXTURE_1D, 0 );
+}
+
+void
+PaletteShader::Bind( GLuint program ) const
+{
+  sf::Uint8 background[4];
+  memcpy( background, &fBackground, sizeof( background ) );
+  glUniform4f( glGetUniformLocation( program, "background" ),
+               background[0] / 255.0f, background[1] / 255.0f, background[2] / 255.0f, background[3] / 255.0f );
+  glUniform1i( glGetUniformLocation( program, "palette" ), 0 );
+  glActiveTexture( GL_TEXTURE0 );
+  glBindTexture( GL_TEXTURE_1D, fTexture );
+}
+
+void
+PaletteShader::Release() const
+{
+  glBindTexture( GL_TEXTURE_1D, 0 );
+}
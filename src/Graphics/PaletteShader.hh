@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::PaletteShader
+///
+/// \brief   The palette texture and shader code shared by the GPU value shaders
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Shader3d's value program and InstancedHits both colour a
+///          scaled value on the GPU. They share the fragment shader
+///          (kFragmentShader, which colours the varying fraction from the
+///          palette texture, or the background outside [0, 1]), the
+///          program build and this palette texture. The texture holds the
+///          ColourPalette lookup table and is only uploaded when the GUI
+///          colours change.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_PaletteShader__
+#define __Viewer_PaletteShader__
+
+#include <SFML/OpenGL.hpp>
+#include <SFML/Config.hpp>
+
+namespace Viewer
+{
+
+class PaletteShader
+{
+public:
+  /// Colours the varying float fraction, uniforms palette (sampler1D) and background (vec4)
+  static const char* kFragmentShader;
+
+  /// Compile and link the shaders, binding the NULL terminated attribute names (may be NULL) to
+  /// their index. Owner names the failures, returns 0 on failure
+  static GLuint BuildProgram( const char* owner,
+                              const char* vertexSource,
+                              const char* fragmentSource,
+                              const char* const* attributes );
+
+  PaletteShader() : fTexture( 0 ), fRevision( 0 ), fBackground( 0 ) { }
+
+  /// Create the palette texture, must be with the GL context active
+  void Create();
+  /// Delete the palette texture
+  void Destroy();
+  /// Upload the palette and background colour if the GUI colours have changed since the last upload
+  void Update();
+  /// Bind the palette to texture unit 0 and set the palette and background uniforms of the program in use
+  void Bind( GLuint program ) const;
+  /// Unbind the palette
+  void Release() const;
+private:
+  GLuint fTexture; /// < 1D palette texture, 0 until created
+  unsigned int fRevision; /// < GUIProperties revision uploaded, 0 if none
+  sf::Uint32 fBackground; /// < Packed colour for out of scaling range values
+};
+
+} // ::Viewer
+
+#endif
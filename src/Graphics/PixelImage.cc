@@ -1,12 +1,110 @@
+#define GL_GLEXT_PROTOTYPES
+
+#include <SFML/OpenGL.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+using namespace std;
+
 #include <Viewer/PixelImage.hh>
 #include <Viewer/GUIProperties.hh>
+#include <Viewer/ConfigurationTable.hh>
 using namespace Viewer;
 
+/// Return true if the textures should be streamed via pixel buffer objects, decided once
+bool
+StreamingEnabled()
+{
+  static int streaming = -1;
+  if( streaming == -1 )
+    {
+      const char* version = reinterpret_cast<const char*>( glGetString( GL_VERSION ) );
+      const char* extensions = reinterpret_cast<const char*>( glGetString( GL_EXTENSIONS ) );
+      const bool supported = version != NULL && extensions != NULL &&
+        ( atof( version ) >= 2.1 || strstr( extensions, "GL_ARB_pixel_buffer_object" ) != NULL );
+      streaming = supported && GUIProperties::GetInstance().GetConfiguration( "Rendering" )->GetI( "pixelStreaming" ) != 0;
+    }
+  return streaming == 1;
+}
+
+PixelImage::~PixelImage()
+{
+  delete[] fPixels;
+  delete[] fBackground;
+  if( fPBO != 0 )
+    glDeleteBuffers( 1, &fPBO );
+}
+
 void
 PixelImage::Construct()
 {
-  fPixels = new sf::Uint8[fWidth * fHeight * 4];
+  fPixels = new sf::Uint32[fWidth * fHeight];
+  fBackground = NULL;
   fTexture.create( fWidth, fHeight );
+  fDirtyTop = 0;
+  fDirtyBottom = fHeight; // Nothing has been uploaded yet
+  fDrawnTop = 0;
+  fDrawnBottom = fHeight;
+  fPBO = 0;
+}
+
+void
+PixelImage::Update()
+{
+  if( fDirtyTop == fDirtyBottom )
+    return;
+  // Full width rows are contiguous, so the band uploads without a staging copy
+  const int rows = fDirtyBottom - fDirtyTop;
+  if( !StreamingEnabled() || !Stream( fDirtyTop, rows ) )
+    fTexture.update( reinterpret_cast<const sf::Uint8*>( fPixels + fDirtyTop * fWidth ), fWidth, rows, 0, fDirtyTop );
+  fDirtyTop = fDirtyBottom = 0;
+}
+
+bool
+PixelImage::Stream( int top,
+                    int rows )
+{
+  if( fPBO == 0 )
+    glGenBuffers( 1, &fPBO );
+  const GLsizeiptr bytes = rows * fWidth * sizeof( sf::Uint32 );
+  glBindBuffer( GL_PIXEL_UNPACK_BUFFER, fPBO );
+  // Orphan the old storage, so the fill need not wait for the previous transfer
+  glBufferData( GL_PIXEL_UNPACK_BUFFER, bytes, NULL, GL_STREAM_DRAW );
+  void* mapped = glMapBuffer( GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY );
+  bool streamed = false;
+  if( mapped != NULL )
+    {
+      memcpy( mapped, fPixels + top * fWidth, bytes );
+      streamed = glUnmapBuffer( GL_PIXEL_UNPACK_BUFFER ) == GL_TRUE; // False if the contents were lost
+    }
+  if( streamed )
+    {
+      // Restore the texture binding afterwards, as sf::Texture::update does
+      GLint previous;
+      glGetIntegerv( GL_TEXTURE_BINDING_2D, &previous );
+      sf::Texture::bind( &fTexture );
+      glTexSubImage2D( GL_TEXTURE_2D, 0, 0, top, fWidth, rows, GL_RGBA, GL_UNSIGNED_BYTE, 0 ); // From the bound buffer
+      glBindTexture( GL_TEXTURE_2D, previous );
+    }
+  glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+  return streamed;
+}
+
+void
+PixelImage::Resize( int width,
+                    int height )
+{
+  if( width == fWidth && height == fHeight )
+    return;
+  delete[] fPixels;
+  delete[] fBackground;
+  if( fPBO != 0 )
+    glDeleteBuffers( 1, &fPBO );
+  fWidth = width;
+  fHeight = height;
+  Construct();
 }
 
 void
@@ -18,13 +116,108 @@ PixelImage::Clear()
 void 
 PixelImage::Clear( Colour fillColour )
 {
-  const unsigned int pixelSize = fWidth * fHeight * 4;
-  for( unsigned int iPixel = 0; iPixel < pixelSize; iPixel+=4 )
+  // Fill the first row, then double the filled region with memcpy each step
+  const size_t pixelCount = fWidth * fHeight;
+  fill( fPixels, fPixels + fWidth, PackColour( fillColour ) );
+  for( size_t filled = fWidth; filled < pixelCount; filled *= 2 )
+    memcpy( fPixels + filled, fPixels, min( filled, pixelCount - filled ) * sizeof( sf::Uint32 ) );
+  MarkDirty( 0, fHeight );
+}
+
+void
+PixelImage::FillRect( int x,
+                      int y,
+                      int width,
+                      int height,
+                      sf::Uint32 colour )
+{
+  const int startX = max( x, 0 );
+  const int endX = min( x + width, fWidth );
+  const int startY = max( y, 0 );
+  const int endY = min( y + height, fHeight );
+  if( startX >= endX || startY >= endY )
+    return; // Entirely off the image
+  for( int yPixel = startY; yPixel < endY; yPixel++ )
+    {
+      sf::Uint32* row = fPixels + yPixel * fWidth;
+      fill( row + startX, row + endX, colour );
+    }
+  MarkDirty( startY, endY );
+}
+
+void
+PixelImage::SetPixels( const sf::Uint32* pixels )
+{
+  memcpy( fPixels, pixels, fWidth * fHeight * sizeof( sf::Uint32 ) );
+  MarkDirty( 0, fHeight );
+}
+
+void
+PixelImage::SetPixels( const sf::Uint32* pixels,
+                       int top,
+                       int bottom )
+{
+  if( fBackground == NULL )
+    {
+      SetPixels( pixels );
+      return;
+    }
+  // The rows drawn last time must be restored as well as the new rows drawn
+  int copyTop = top;
+  int copyBottom = bottom;
+  if( fDrawnTop != fDrawnBottom )
+    {
+      copyTop = top < bottom ? min( top, fDrawnTop ) : fDrawnTop;
+      copyBottom = top < bottom ? max( bottom, fDrawnBottom ) : fDrawnBottom;
+    }
+  if( copyTop >= copyBottom )
+    return; // Already the background
+  memcpy( fPixels + copyTop * fWidth, pixels + copyTop * fWidth, ( copyBottom - copyTop ) * fWidth * sizeof( sf::Uint32 ) );
+  MarkDirty( copyTop, copyBottom );
+  // Only the new rows now differ from the background
+  fDrawnTop = top < bottom ? top : 0;
+  fDrawnBottom = top < bottom ? bottom : 0;
+}
+
+void
+PixelImage::Blit( const PixelImage& source,
+                  int x,
+                  int y )
+{
+  const int startX = max( x, 0 );
+  const int endX = min( x + source.fWidth, fWidth );
+  const int startY = max( y, 0 );
+  const int endY = min( y + source.fHeight, fHeight );
+  if( startX >= endX || startY >= endY )
+    return;
+  for( int yPixel = startY; yPixel < endY; yPixel++ )
+    memcpy( fPixels + yPixel * fWidth + startX, 
+            source.fPixels + ( yPixel - y ) * source.fWidth + ( startX - x ), 
+            ( endX - startX ) * sizeof( sf::Uint32 ) );
+  MarkDirty( startY, endY );
+}
+
+void
+PixelImage::SaveBackground()
+{
+  if( fBackground == NULL )
+    fBackground = new sf::Uint32[fWidth * fHeight];
+  memcpy( fBackground, fPixels, fWidth * fHeight * sizeof( sf::Uint32 ) );
+  fDrawnTop = fDrawnBottom = 0;
+}
+
+void
+PixelImage::RestoreBackground()
+{
+  if( fBackground == NULL )
+    Clear();
+  else
     {
-      fPixels[iPixel]     = fillColour.r;
-      fPixels[iPixel + 1] = fillColour.g;
-      fPixels[iPixel + 2] = fillColour.b;
-      fPixels[iPixel + 3] = fillColour.a;      
+      // Only the rows drawn since the background was saved or restored differ
+      if( fDrawnTop == fDrawnBottom )
+        return;
+      memcpy( fPixels + fDrawnTop * fWidth, fBackground + fDrawnTop * fWidth, ( fDrawnBottom - fDrawnTop ) * fWidth * sizeof( sf::Uint32 ) );
+      MarkDirty( fDrawnTop, fDrawnBottom );
+      fDrawnTop = fDrawnBottom = 0;
     }
-  Update();
 }
@@ -10,6 +10,15 @@
 ///     18/02/12 : P.Jones - Second Revision, use textures. \n
 ///
 /// \detail  Quick way to draw very many objects in a pixel area. 
+///          Pixels are held as packed RGBA words in row major order, all
+///          drawing should be done in horizontal spans via FillRect.
+///          Static content can be drawn once and saved as the background,
+///          which is then restored before each redraw, copying only the
+///          rows drawn over it. Drawing marks the changed rows, Update
+///          uploads only that contiguous band. If the Rendering
+///          pixelStreaming option is set (and supported) the band is
+///          streamed via a pixel buffer object, orphaned before each fill
+///          so the driver need not wait for the previous transfer.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -17,9 +26,12 @@
 #define __Viewer_PixelImage__
 
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/OpenGL.hpp>
 #include <SFML/Config.hpp>
 
 #include <cmath>
+#include <cstring>
+#include <algorithm>
 
 #include <Viewer/RectPtr.hh>
 #include <Viewer/Colour.hh>
@@ -37,12 +49,40 @@ public:
   inline PixelImage( RectPtr rect,
                      const int width, 
                      const int height );
+  ~PixelImage();
   /// Clear the texture to the current GUI bg colour
   void Clear();
   /// Clear the texture with a colour
   void Clear( Colour fillColour );
-  /// Must call after changes to the pixels
-  inline void Update();
+  /// Fill the rect (in pixels) with the packed colour, clipped to the image
+  void FillRect( int x, 
+                 int y, 
+                 int width, 
+                 int height, 
+                 sf::Uint32 colour );
+  /// Copy the source image into this image with its top left at x, y, clipped to the image
+  void Blit( const PixelImage& source,
+             int x,
+             int y );
+  /// Save the current pixels as the background layer
+  void SaveBackground();
+  /// Restore the pixels to the saved background layer (clears if none saved)
+  void RestoreBackground();
+  /// Replace all the pixels with a copy of pixels, which must match the image size
+  void SetPixels( const sf::Uint32* pixels );
+  /// As above, but rows outside [top, bottom) of pixels must equal the saved background, only changed rows are copied
+  void SetPixels( const sf::Uint32* pixels,
+                  int top,
+                  int bottom );
+  /// Return the pixels, row major
+  inline const sf::Uint32* GetPixels() const;
+  /// Reallocate the image at a new size, the pixels and background are lost
+  void Resize( int width,
+               int height );
+  /// Must call after changes to the pixels, uploads the changed rows
+  void Update();
+  /// Pack the colour into a pixel word, RGBA byte order in memory
+  static inline sf::Uint32 PackColour( const Colour& colour );
   /// Return the texture
   inline sf::Texture& GetTexture();
   /// Return the local Rect
@@ -53,12 +93,28 @@ public:
 protected:
   /// Construct the texture and pixels
   void Construct();
+  /// Mark the rows [top, bottom) as changed, for upload and since the background
+  inline void MarkDirty( int top, 
+                         int bottom );
+  /// Upload the rows via the pixel buffer object, returns false if it could not be mapped
+  bool Stream( int top,
+               int rows );
 
   RectPtr fLocalRect; /// < The text local rect
   sf::Texture fTexture; /// < SFML image, must exist in memory
-  sf::Uint8* fPixels; /// < Pixel buffer RGBA (as word)
+  sf::Uint32* fPixels; /// < Pixel buffer RGBA (as word)
+  sf::Uint32* fBackground; /// < Saved background layer, NULL until saved
   int fWidth;  /// < Image width in pixels
   int fHeight; /// < Image height in pixels
+  int fDirtyTop; /// < First changed row
+  int fDirtyBottom; /// < One past the last changed row, equal to fDirtyTop if none changed
+  int fDrawnTop; /// < First row changed since the background was saved or restored
+  int fDrawnBottom; /// < One past the last such row, equal to fDrawnTop if none changed
+  GLuint fPBO; /// < Pixel buffer object, 0 until first streamed
+private:
+  /// Prevent usage of methods below, the pixels are owned
+  PixelImage( const PixelImage& );
+  void operator=( const PixelImage& );
 };
 
 inline 
@@ -85,9 +141,35 @@ PixelImage::PixelImage( RectPtr rect,
 }
 
 inline void
-PixelImage::Update()
+PixelImage::MarkDirty( int top,
+                       int bottom )
 {
-  fTexture.update( fPixels );
+  if( fDirtyTop == fDirtyBottom )
+    {
+      fDirtyTop = top;
+      fDirtyBottom = bottom;
+    }
+  else
+    {
+      fDirtyTop = std::min( fDirtyTop, top );
+      fDirtyBottom = std::max( fDirtyBottom, bottom );
+    }
+  if( fDrawnTop == fDrawnBottom )
+    {
+      fDrawnTop = top;
+      fDrawnBottom = bottom;
+    }
+  else
+    {
+      fDrawnTop = std::min( fDrawnTop, top );
+      fDrawnBottom = std::max( fDrawnBottom, bottom );
+    }
+}
+
+inline sf::Uint32
+PixelImage::PackColour( const Colour& colour )
+{
+  return colour.GetPacked();
 }
 
 inline sf::Texture& 
@@ -102,6 +184,12 @@ PixelImage::GetRect() const
   return fLocalRect;
 }
 
+inline const sf::Uint32*
+PixelImage::GetPixels() const
+{
+  return fPixels;
+}
+
 inline int
 PixelImage::GetWidth() const
 {
@@ -20,27 +20,16 @@ ProjectionImage::DrawSquare( const sf::Vector2<int>& position,
                              const sf::Vector2<int>& size,
                              const Colour& colour )
 {
-  const int startX = position.x;
-  int endX = startX + size.x;
-  if( endX >= fWidth )
-    endX = fWidth - 1;
-  const int startY = position.y;
-  int endY = startY + size.y;
-  if( endY >= fHeight )
-    endY = fHeight - 1;
-  if( startX < 0 || startY < 0 || endX >= fWidth || endY >= fHeight )
-    // Bad coordinates given
-    return;
+  DrawSquare( position, size, PackColour( colour ) );
+}
 
-  for( int xPixel = startX; xPixel <= endX; xPixel++ )
-    for( int yPixel = startY; yPixel <= endY; yPixel++ )
-      {
-        int pixel = ( xPixel + yPixel * fWidth ) * 4;
-        fPixels[pixel] = colour.r;
-        fPixels[pixel + 1] = colour.g;
-        fPixels[pixel + 2] = colour.b;
-        fPixels[pixel + 3] = colour.a;
-      }
+void
+ProjectionImage::DrawSquare( const sf::Vector2<int>& position,
+                             const sf::Vector2<int>& size,
+                             sf::Uint32 colour )
+{
+  // Size is inclusive, a zero size is a single pixel
+  FillRect( position.x, position.y, size.x + 1, size.y + 1, colour );
 }
 
 void
@@ -52,6 +41,15 @@ ProjectionImage::DrawSquare( const sf::Vector2<double>& position,
   DrawSquare( posPixel, fSquareSize, colour );
 }
 
+void
+ProjectionImage::DrawSquare( const sf::Vector2<double>& position,
+                             sf::Uint32 colour )
+{
+  sf::Vector2<int> posPixel( static_cast<int>( position.x * fWidth ), 
+                             static_cast<int>( position.y * fHeight ) );
+  DrawSquare( posPixel, fSquareSize, colour );
+}
+
 void 
 ProjectionImage::DrawSquare( const sf::Vector2<double>& position,
                              const sf::Vector2<double>& size,
@@ -103,6 +101,7 @@ ProjectionImage::DrawHollowSquare( const sf::Vector2<int>& position,
 void 
 ProjectionImage::SetSquareSize( const sf::Vector2<double>& size )
 {
+  fLocalSquareSize = size;
   fSquareSize = sf::Vector2<int>( static_cast<int>( size.x * fWidth ), 
                                   static_cast<int>( size.y * fHeight ) ); 
   if( fSquareSize.x < 1 )
@@ -117,3 +116,11 @@ ProjectionImage::GetSquareSize()
   return sf::Vector2<double>( static_cast<double>( fSquareSize.x ) / static_cast<double>( fWidth ), 
                               static_cast<double>( fSquareSize.y ) / static_cast<double>( fHeight ) );
 }
+
+void
+ProjectionImage::Resize( int width,
+                         int height )
+{
+  PixelImage::Resize( width, height );
+  SetSquareSize( fLocalSquareSize );
+}
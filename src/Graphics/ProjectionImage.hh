@@ -30,12 +30,18 @@ public:
   ProjectionImage( RectPtr rect,
                    const int width,
                    const int height ) : PixelImage( rect, width, height ) { }
+  /// Reallocate the image at a new size, the standard square size is kept in local coords
+  void Resize( int width,
+               int height );
   void DrawDot( const sf::Vector2<double>& position,  /// < In local Coords
                 const Colour& colour ); 
 
   /// Draw a standard size square
   void DrawSquare( const sf::Vector2<double>& position, /// < In local Coords
                    const Colour& colour ); 
+  /// Draw a standard size square with a packed colour
+  void DrawSquare( const sf::Vector2<double>& position, /// < In local Coords
+                   sf::Uint32 colour ); 
 
   void DrawSquare( const sf::Vector2<double>& position, /// < In local Coords 
                    const sf::Vector2<double>& size,     /// < In local Coords
@@ -51,11 +57,17 @@ public:
   void SetSquareSize( const sf::Vector2<double>& size ); /// < In local Coords
   /// Get the standard square size
   sf::Vector2<double> GetSquareSize(); /// < In local Coords
+  /// Get the standard square size in pixels, inclusive
+  sf::Vector2<int> GetPixelSquareSize() const { return fSquareSize; }
 
-  /// Draw square function with known pixel sizes
+  /// Draw square function with known pixel sizes, clipped to the image
   void DrawSquare( const sf::Vector2<int>& position, /// < In pixels
                    const sf::Vector2<int>& size, /// < In pixels
                    const Colour& colour );
+  /// Draw square function with known pixel sizes and a packed colour, clipped to the image
+  void DrawSquare( const sf::Vector2<int>& position, /// < In pixels
+                   const sf::Vector2<int>& size, /// < In pixels
+                   sf::Uint32 colour );
   /// Draw a hollow square with known pixel sizes
   void DrawHollowSquare( const sf::Vector2<int>& position,
                          const sf::Vector2<int>& size,
@@ -63,6 +75,7 @@ public:
                          const int borderSize );
 private:
   sf::Vector2<int> fSquareSize; /// < Standard size of a square
+  sf::Vector2<double> fLocalSquareSize; /// < Standard size of a square in local coords
 };
 
 } // ::Viewer
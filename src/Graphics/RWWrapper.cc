@@ -1,20 +1,27 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
+#include <SFML/OpenGL.hpp>
 
 #include <sstream>
+#include <string>
+#include <map>
+using namespace std;
 
 #include <Viewer/RWWrapper.hh>
 #include <Viewer/RectPtr.hh>
 #include <Viewer/Rect.hh>
 #include <Viewer/Sprite.hh>
 #include <Viewer/PixelImage.hh>
+#include <Viewer/InstancedHits.hh>
 #include <Viewer/Text.hh>
 #include <Viewer/GUIProperties.hh>
 #include <Viewer/ConfigurationTable.hh>
 using namespace Viewer;
 
+const unsigned int kMaxCachedText = 512; // Unused layouts are pruned beyond this
+
 RWWrapper::RWWrapper( sf::RenderWindow& renderWindow )
-  : fRenderWindow( renderWindow )
+  : fTextBatch( sf::Quads ), fRenderWindow( renderWindow ), fBatchCharSize( 0 ), fFrame( 0 )
 {
   stringstream fontFileName;
   fontFileName << getenv( "VIEWERROOT" ) << "/gui/" << GUIProperties::GetInstance().GetConfiguration( "Font" )->GetS( "type" );
@@ -34,29 +41,20 @@ RWWrapper::Draw( Sprite& object )
 void 
 RWWrapper::Draw( Text& object )
 {
-  sf::Text sfmlText( object.GetString(), fFont );
-  sf::Rect<double> resPos = object.GetRect()->GetRect( Rect::eResolution );
-  if( object.GetCharSize() > 0 )
-    sfmlText.setCharacterSize( object.GetCharSize() );
-  else
+  const sf::Rect<double> resPos = object.GetRect()->GetRect( Rect::eResolution );
+  const TextLayout& layout = GetTextLayout( object, resPos );
+  if( layout.fCharSize != fBatchCharSize )
+    Flush(); // Different atlas texture
+  fBatchCharSize = layout.fCharSize;
+  const sf::Vector2f offset( resPos.left, resPos.top );
+  const sf::Color colour = object.GetColour();
+  for( unsigned int iVertex = 0; iVertex < layout.fVertices.getVertexCount(); iVertex++ )
     {
-      // First find the largest character size that works
-      for( unsigned int charSize = 2; charSize < 40; charSize++ )
-        {
-          sfmlText.setCharacterSize( charSize );
-          const sf::Rect<float> bounds = sfmlText.getGlobalBounds();
-          if( bounds.width > resPos.width || bounds.height > resPos.height )
-            {
-              sfmlText.setCharacterSize( charSize - 1 );
-              break;
-            }
-        }
+      sf::Vertex vertex = layout.fVertices[iVertex];
+      vertex.position += offset;
+      vertex.color = colour;
+      fTextBatch.append( vertex );
     }
-  double yOffset = sfmlText.getGlobalBounds().top;
-  // Now se the position
-  sfmlText.setPosition( resPos.left - sfmlText.getGlobalBounds().left, resPos.top - yOffset );
-  sfmlText.setColor( object.GetColour() );
-  DrawObject( sfmlText );
 }
 
 void
@@ -69,12 +67,170 @@ RWWrapper::Draw( PixelImage& object )
   DrawObject( sfmlSprite );
 }
 
+void 
+RWWrapper::Draw( InstancedHits& object )
+{
+  Flush();
+  // Raw OpenGL within the sfml 2d drawing, must preserve and then reset the sfml state
+  glPushAttrib( GL_ALL_ATTRIB_BITS );
+  glMatrixMode( GL_PROJECTION );
+  glPushMatrix();
+  glMatrixMode( GL_MODELVIEW );
+  glPushMatrix();
+  object.Render();
+  glMatrixMode( GL_PROJECTION );
+  glPopMatrix();
+  glMatrixMode( GL_MODELVIEW );
+  glPopMatrix();
+  glPopAttrib();
+  fRenderWindow.resetGLStates();
+}
+
+void
+RWWrapper::NewFrame()
+{
+  fClock.restart();
+  if( fTextCache.size() > kMaxCachedText )
+    {
+      // Prune the layouts not drawn in the last frame, e.g. old mouse over info
+      for( map<TextKey, TextLayout>::iterator iTer = fTextCache.begin(); iTer != fTextCache.end(); )
+        {
+          if( iTer->second.fLastFrame != fFrame )
+            fTextCache.erase( iTer++ );
+          else
+            iTer++;
+        }
+    }
+  fFrame++;
+}
+
+void
+RWWrapper::Flush()
+{
+  if( fTextBatch.getVertexCount() == 0 )
+    return;
+  sf::RenderStates states;
+  states.texture = &fFont.getTexture( fBatchCharSize );
+  fRenderWindow.draw( fTextBatch, states );
+  fTextBatch.clear();
+}
+
 void 
 RWWrapper::DrawObject( sf::Drawable& object )
 {
+  Flush();
   fRenderWindow.draw( object );
 }
 
+const RWWrapper::TextLayout&
+RWWrapper::GetTextLayout( Text& object,
+                          const sf::Rect<double>& resPos )
+{
+  TextKey key;
+  key.fString = object.GetString();
+  key.fWidth = resPos.width;
+  key.fHeight = resPos.height;
+  key.fCharSize = object.GetCharSize();
+  map<TextKey, TextLayout>::iterator found = fTextCache.find( key );
+  if( found != fTextCache.end() )
+    {
+      found->second.fLastFrame = fFrame;
+      return found->second;
+    }
+
+  TextLayout& layout = fTextCache[key];
+  layout.fVertices.setPrimitiveType( sf::Quads );
+  layout.fLastFrame = fFrame;
+  sf::Rect<float> bounds;
+  if( key.fCharSize > 0 )
+    {
+      layout.fCharSize = key.fCharSize;
+      bounds = LayoutText( key.fString, layout.fCharSize, layout.fVertices );
+    }
+  else
+    {
+      // Find the largest character size that fits, only done once per key
+      layout.fCharSize = 39;
+      for( unsigned int charSize = 2; charSize < 40; charSize++ )
+        {
+          bounds = LayoutText( key.fString, charSize, layout.fVertices );
+          if( bounds.width > resPos.width || bounds.height > resPos.height )
+            {
+              layout.fCharSize = charSize - 1;
+              break;
+            }
+        }
+      bounds = LayoutText( key.fString, layout.fCharSize, layout.fVertices );
+    }
+  // Place the text top left at the origin
+  for( unsigned int iVertex = 0; iVertex < layout.fVertices.getVertexCount(); iVertex++ )
+    layout.fVertices[iVertex].position -= sf::Vector2f( bounds.left, bounds.top );
+  return layout;
+}
+
+sf::Rect<float>
+RWWrapper::LayoutText( const string& text,
+                       unsigned int charSize,
+                       sf::VertexArray& vertices )
+{
+  // Matches the sf::Text layout, regular style
+  vertices.clear();
+  const float hSpace = static_cast<float>( fFont.getGlyph( L' ', charSize, false ).advance );
+  const float vSpace = static_cast<float>( fFont.getLineSpacing( charSize ) );
+  float x = 0.0f;
+  float y = static_cast<float>( charSize );
+  sf::Uint32 previous = 0;
+  for( string::const_iterator iTer = text.begin(); iTer != text.end(); iTer++ )
+    {
+      const sf::Uint32 current = static_cast<unsigned char>( *iTer );
+      x += static_cast<float>( fFont.getKerning( previous, current, charSize ) );
+      previous = current;
+      switch( current )
+        {
+        case ' ':
+          x += hSpace;
+          continue;
+        case '\t':
+          x += hSpace * 4;
+          continue;
+        case '\n':
+          y += vSpace;
+          x = 0.0f;
+          continue;
+        case '\v':
+          y += vSpace * 4;
+          continue;
+        }
+      const sf::Glyph& glyph = fFont.getGlyph( current, charSize, false );
+      const float left = static_cast<float>( glyph.bounds.left );
+      const float top = static_cast<float>( glyph.bounds.top );
+      const float right = left + static_cast<float>( glyph.bounds.width );
+      const float bottom = top + static_cast<float>( glyph.bounds.height );
+      const float u1 = static_cast<float>( glyph.textureRect.left );
+      const float v1 = static_cast<float>( glyph.textureRect.top );
+      const float u2 = u1 + static_cast<float>( glyph.textureRect.width );
+      const float v2 = v1 + static_cast<float>( glyph.textureRect.height );
+      vertices.append( sf::Vertex( sf::Vector2f( x + left, y + top ), sf::Vector2f( u1, v1 ) ) );
+      vertices.append( sf::Vertex( sf::Vector2f( x + right, y + top ), sf::Vector2f( u2, v1 ) ) );
+      vertices.append( sf::Vertex( sf::Vector2f( x + right, y + bottom ), sf::Vector2f( u2, v2 ) ) );
+      vertices.append( sf::Vertex( sf::Vector2f( x + left, y + bottom ), sf::Vector2f( u1, v2 ) ) );
+      x += static_cast<float>( glyph.advance );
+    }
+  return vertices.getBounds();
+}
+
+bool
+RWWrapper::TextKey::operator<( const TextKey& rhs ) const
+{
+  if( fString != rhs.fString )
+    return fString < rhs.fString;
+  if( fWidth != rhs.fWidth )
+    return fWidth < rhs.fWidth;
+  if( fHeight != rhs.fHeight )
+    return fHeight < rhs.fHeight;
+  return fCharSize < rhs.fCharSize;
+}
+
 sf::Time
 RWWrapper::GetFrameTime()
 {
@@ -9,7 +9,11 @@
 ///     29/06/11 : P.Jones - First Revision, new file. \n
 ///
 /// \detail  Allows convineince of Drawing without having to cooridinate
-///          correct
+///          correct. Text is laid out from the font glyph atlas once per
+///          string, rect size and char size, the layout (fitted char size
+///          and glyph quads) is cached. Consecutive text draws with the
+///          same char size (atlas texture) are batched into one draw call,
+///          Flush must be called before any drawing not via this class.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -18,6 +22,11 @@
 
 #include <SFML/System/Clock.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <string>
+#include <map>
 
 namespace sf
 {
@@ -31,6 +40,7 @@ namespace Viewer
   class Sprite;
   class Text;
   class PixelImage;
+  class InstancedHits;
 
 class RWWrapper
 {
@@ -44,25 +54,51 @@ public:
   void Draw( Text& object );
   /// Draw a pixel image onto the screen
   void Draw( PixelImage& object );
+  /// Draw instanced hits onto the screen, raw OpenGL
+  void Draw( InstancedHits& object );
   /// Return the time elapsed since the last frame
   sf::Time GetFrameTime();
   /// Called on new frame
-  inline void NewFrame();
+  void NewFrame();
+  /// Draw any batched text, call at the end of the frame
+  void Flush();
 protected:
+  /// Cache key, the string, rect size in resolution coords and fixed char size (0 if fitted)
+  struct TextKey
+  {
+    std::string fString;
+    double fWidth;
+    double fHeight;
+    unsigned int fCharSize;
+    bool operator<( const TextKey& rhs ) const;
+  };
+  /// Cached text layout, positioned with the text top left at the origin
+  struct TextLayout
+  {
+    sf::VertexArray fVertices; /// < Glyph quads, texture coords in the fCharSize atlas
+    unsigned int fCharSize; /// < The (fitted) char size
+    unsigned int fLastFrame; /// < Frame this was last drawn in
+  };
+
   /// Draw a sfml Drawable (everything that can be drawn is drawable)
   void DrawObject( sf::Drawable& object );
+  /// Return the cached layout for the text, laying it out if not cached
+  const TextLayout& GetTextLayout( Text& object,
+                                   const sf::Rect<double>& resPos );
+  /// Layout the text at the char size into vertices, returns the bounds
+  sf::Rect<float> LayoutText( const std::string& text,
+                              unsigned int charSize,
+                              sf::VertexArray& vertices );
 
+  std::map<TextKey, TextLayout> fTextCache; /// < Text layouts
+  sf::VertexArray fTextBatch; /// < Text quads to draw on Flush
   sf::Clock fClock; /// < Calculates the time between frames
   sf::RenderWindow& fRenderWindow; /// < Reference to the RenderWindow
   sf::Font fFont;
+  unsigned int fBatchCharSize; /// < Char size (atlas texture) of the batched text
+  unsigned int fFrame; /// < Frame count
 };
 
-inline void
-RWWrapper::NewFrame()
-{
-  fClock.restart();
-}
-
 } // ::Viewer
 
 #endif
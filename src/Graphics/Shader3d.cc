@@ -0,0 +1,126 @@
+#define GL_GLEXT_PROTOTYPES
+
+#include <SFML/OpenGL.hpp>
+
+#include <cstring>
+#include <cstdlib>
+using namespace std;
+
+#include <Viewer/Shader3d.hh>
+#include <Viewer/Colour.hh>
+using namespace Viewer;
+
+const char* kVertexShader3d =
+  "#version 120\n"
+  "attribute vec3 position;\n"
+  "attribute vec4 colour;\n" // Normalised from the packed bytes
+  "varying vec4 vertexColour;\n"
+  "void main()\n"
+  "{\n"
+  "  vertexColour = colour;\n"
+  "  gl_Position = gl_ModelViewProjectionMatrix * vec4( position, 1.0 );\n"
+  "}\n";
+
+const char* kFragmentShader3d =
+  "#version 120\n"
+  "varying vec4 vertexColour;\n"
+  "void main()\n"
+  "{\n"
+  "  gl_FragColor = vertexColour;\n"
+  "}\n";
+
+const char* kValueVertexShader3d =
+  "#version 120\n"
+  "attribute vec3 position;\n"
+  "attribute float value;\n"
+  "uniform vec2 scaling;\n" // min, max
+  "varying float fraction;\n"
+  "void main()\n"
+  "{\n"
+  "  fraction = ( value - scaling.x ) / max( scaling.y - scaling.x, 1.0e-6 );\n"
+  "  gl_Position = gl_ModelViewProjectionMatrix * vec4( position, 1.0 );\n"
+  "}\n";
+
+Shader3d::Shader3d()
+  : fValueProgram( 0 )
+{
+  fScaling[0] = 0.0f;
+  fScaling[1] = 0.0f;
+  fProgram = BuildProgram( kVertexShader3d, kFragmentShader3d );
+  if( fProgram == 0 )
+    return;
+  fValueProgram = BuildProgram( kValueVertexShader3d, PaletteShader::kFragmentShader );
+  if( fValueProgram == 0 )
+    {
+      // Both or neither, the VBOs only check IsValid
+      glDeleteProgram( fProgram );
+      fProgram = 0;
+      return;
+    }
+  fPalette.Create();
+  SetPalette();
+}
+
+Shader3d::~Shader3d()
+{
+  // The GL context is gone by static destruction, nothing to delete
+}
+
+void
+Shader3d::Use( EProgram program ) const
+{
+  if( program == eColourProgram )
+    {
+      glUseProgram( fProgram );
+      return;
+    }
+  glUseProgram( fValueProgram );
+  glUniform2f( glGetUniformLocation( fValueProgram, "scaling" ), fScaling[0], fScaling[1] );
+  fPalette.Bind( fValueProgram );
+}
+
+void
+Shader3d::Release() const
+{
+  fPalette.Release();
+  glUseProgram( 0 );
+}
+
+void
+Shader3d::SetColour( const Colour& colour ) const
+{
+  if( fProgram != 0 )
+    glVertexAttrib4f( eColour, colour.r / 255.0f, colour.g / 255.0f, colour.b / 255.0f, colour.a / 255.0f );
+  else
+    colour.SetOpenGL();
+}
+
+void
+Shader3d::SetScaling( double min,
+                      double max ) const
+{
+  fScaling[0] = static_cast<float>( min );
+  fScaling[1] = static_cast<float>( max );
+}
+
+void
+Shader3d::SetPalette()
+{
+  if( fProgram != 0 )
+    fPalette.Update();
+}
+
+GLuint
+Shader3d::BuildProgram( const char* vertexSource,
+                        const char* fragmentSource )
+{
+  const char* extensions = reinterpret_cast<const char*>( glGetString( GL_EXTENSIONS ) );
+  const char* version = reinterpret_cast<const char*>( glGetString( GL_VERSION ) );
+  if( extensions == NULL || version == NULL || atoi( version ) < 2 )
+    return 0;
+  if( atoi( version ) < 3 && strstr( extensions, "GL_ARB_vertex_array_object" ) == NULL )
+    return 0;
+  // Indexed by EAttribute
+  const char* attributes[4] = { "position", "colour", "value", NULL };
+  return PaletteShader::BuildProgram( "Shader3d", vertexSource, fragmentSource, attributes );
+}
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::Shader3d
+///
+/// \brief   The shader program used to draw the 3d VBOs
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  A minimal GLSL 1.20 program, position and packed colour
+///          attributes transformed by the fixed function matrices (so the
+///          Frame3d cameras are unchanged). The program is built on first
+///          use, which must be with the window GL context active. If the
+///          GPU lacks shaders or vertex array objects IsValid is false and
+///          the VBOs fall back to fixed function client state. The value
+///          program instead takes a float value per vertex and applies the
+///          scaling (a uniform) and the palette (a PaletteShader texture)
+///          on the GPU, so a scaling or palette change needs no buffer
+///          upload. This is a singleton class.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_Shader3d__
+#define __Viewer_Shader3d__
+
+#include <SFML/OpenGL.hpp>
+
+#include <Viewer/PaletteShader.hh>
+
+namespace Viewer
+{
+  class Colour;
+
+class Shader3d
+{
+public:
+  /// Fixed attribute locations, position must be 0 (aliases gl_Vertex)
+  enum EAttribute { ePosition = 0, eColour = 1, eValue = 2 };
+  /// The programs, colour attribute or value attribute
+  enum EProgram { eColourProgram, eValueProgram };
+
+  /// Singleton class instance
+  static Shader3d& GetInstance();
+  ~Shader3d();
+
+  /// Return true if the program (and vertex array objects) are supported
+  bool IsValid() const { return fProgram != 0; }
+  /// Use the program, the value program with the last SetScaling scaling
+  void Use( EProgram program = eColourProgram ) const;
+  /// Stop using the program
+  void Release() const;
+  /// Set the colour used when the colour attribute array is disabled
+  void SetColour( const Colour& colour ) const;
+  /// Set the value program scaling, values outside min to max are drawn in the background colour
+  void SetScaling( double min,
+                   double max ) const;
+  /// Upload the palette texture if the GUI colours have changed, otherwise does nothing
+  void SetPalette();
+private:
+  /// Compile and link the shader program, returns 0 on failure or if not supported
+  GLuint BuildProgram( const char* vertexSource,
+                       const char* fragmentSource );
+
+  PaletteShader fPalette; /// < Value program palette texture
+  mutable float fScaling[2]; /// < Value program scaling min, max
+  GLuint fProgram; /// < Shader program, 0 if not supported
+  GLuint fValueProgram; /// < Value shader program, 0 if not supported
+
+  /// Prevent usage of methods below
+  Shader3d();
+  Shader3d( Shader3d& );
+  void operator=( Shader3d& );
+};
+
+inline Shader3d&
+Shader3d::GetInstance()
+{
+  static Shader3d shader3d;
+  return shader3d;
+}
+
+} // ::Viewer
+
+#endif
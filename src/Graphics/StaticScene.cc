@@ -0,0 +1,121 @@
+#define GL_GLEXT_PROTOTYPES
+
+#include <Viewer/Colour.hh>
+#include <Viewer/StaticScene.hh>
+#include <Viewer/Shader3d.hh>
+
+namespace Viewer {
+
+StaticScene::StaticScene()
+    : fDirty( true )
+{
+    for( int state = 0; state < eStateCount; state++ )
+    {
+        glGenBuffers( 1, &fStateVBOID[state] );
+        fStateCapacity[state] = 0;
+        fStateCount[state] = 0;
+        fStateVAOID[state] = 0;
+    }
+}
+
+StaticScene::~StaticScene()
+{
+    for( int state = 0; state < eStateCount; state++ )
+    {
+        glDeleteBuffers( 1, &fStateVBOID[state] );
+        if( Shader3d::GetInstance().IsValid() )
+            glDeleteVertexArrays( 1, &fStateVAOID[state] );
+    }
+}
+
+void StaticScene::Clear()
+{
+    VBO::Clear();
+    fGroups.clear();
+    fDirty = true;
+}
+
+void StaticScene::NewGroup( const bool& visible )
+{
+    fGroups.push_back( Group() );
+    fGroups.back().fVisible = &visible;
+}
+
+void StaticScene::AddIndex( EState state, GLuint index )
+{
+    fGroups.back().fIndices[state].push_back( index );
+}
+
+void StaticScene::AddVBO( EState state, const VBO& vbo )
+{
+    const GLuint b = fVertices.size();
+    fVertices.insert( fVertices.end(), vbo.fVertices.begin(), vbo.fVertices.end() );
+    for( std::vector<GLuint>::const_iterator iTer = vbo.fIndices.begin(); iTer != vbo.fIndices.end(); iTer++ )
+        AddIndex( state, b + *iTer );
+}
+
+void StaticScene::AddVBO( EState state, const VBO& vbo, const Colour& colour )
+{
+    const size_t b = fVertices.size();
+    AddVBO( state, vbo );
+    for( size_t i = b; i < fVertices.size(); i++ )
+    {
+        fVertices[i].r = colour.r;
+        fVertices[i].g = colour.g;
+        fVertices[i].b = colour.b;
+        fVertices[i].a = colour.a;
+    }
+}
+
+void StaticScene::Bind()
+{
+    Upload( GL_ARRAY_BUFFER, fVertexVBOID, fVertices.empty() ? NULL : &fVertices[0], fVertices.size()*sizeof(struct Vertex::Data), fVertexCapacity );
+    fDirty = true;
+}
+
+void StaticScene::RenderDepth()
+{
+    Update();
+    glEnable( GL_DEPTH_TEST );
+    // Occluders only write depth, hiding the lines and hits behind them
+    glColorMask( GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE );
+    DrawState( eOccluders, GL_TRIANGLES );
+    glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+    DrawState( eDepthLines, GL_LINES );
+    glDisable( GL_DEPTH_TEST );
+}
+
+void StaticScene::RenderOverlay()
+{
+    glDisable( GL_DEPTH_TEST );
+    DrawState( eOverlayTriangles, GL_TRIANGLES );
+    DrawState( eOverlayLines, GL_LINES );
+    glEnable( GL_DEPTH_TEST );
+}
+
+void StaticScene::Update()
+{
+    std::vector<bool> visible( fGroups.size() );
+    for( size_t group = 0; group < fGroups.size(); group++ )
+        visible[group] = *fGroups[group].fVisible;
+    if( !fDirty && visible == fBuiltVisible )
+        return;
+    fBuiltVisible.swap( visible );
+    fDirty = false;
+    for( int state = 0; state < eStateCount; state++ )
+    {
+        fStateIndices.clear();
+        for( size_t group = 0; group < fGroups.size(); group++ )
+            if( fBuiltVisible[group] )
+                fStateIndices.insert( fStateIndices.end(), fGroups[group].fIndices[state].begin(), fGroups[group].fIndices[state].end() );
+        fStateCount[state] = fStateIndices.size();
+        Upload( GL_ELEMENT_ARRAY_BUFFER, fStateVBOID[state], fStateIndices.empty() ? NULL : &fStateIndices[0], fStateIndices.size()*sizeof(GLuint), fStateCapacity[state] );
+    }
+}
+
+void StaticScene::DrawState( EState state, GLenum mode ) const
+{
+    Draw( mode, fStateCount[state], fStateVAOID[state], fVertexVBOID, sizeof( struct Vertex::Data ), 3*sizeof(float), fStateVBOID[state] );
+}
+
+}; // namespace Viewer
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////
+/// \class StaticScene
+///
+/// \brief  Batches the static (per run) 3d geometry of a frame.
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  The 3d modules add their static geometry (Module3d::BuildStatic)
+///          as groups into a single vertex buffer, each group has indices
+///          per draw state and is shown if its visible flag (owned by the
+///          module) is true. The indices of the visible groups are merged
+///          per state, so the whole scene is a draw call per state. The
+///          merged indices are only rebuilt when a visible flag changes.
+///          RenderDepth draws the depth tested states and should be called
+///          before the modules render, RenderOverlay draws the states
+///          without depth test and should be called after. \n
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_StaticScene__
+#define __Viewer_StaticScene__
+
+#include <vector>
+
+#include <Viewer/VBO.hh>
+
+namespace Viewer {
+    class Colour;
+
+class StaticScene : public VBO {
+public:
+    /// The draw states, in draw order
+    enum EState { eOccluders, eDepthLines, eOverlayTriangles, eOverlayLines, eStateCount };
+
+    StaticScene();
+    ~StaticScene();
+
+    /// Remove all the groups and geometry, call before adding the run geometry
+    void Clear();
+    /// Start a new group, subsequent indices are added to it. It is shown if visible is true
+    void NewGroup( const bool& visible );
+    /// Add an index (of a vertex in fVertices) in the state to the current group
+    void AddIndex( EState state, GLuint index );
+    /// Add the vbo vertices and indices in the state to the current group
+    void AddVBO( EState state, const VBO& vbo );
+    /// Add the vbo vertices, in the colour, and indices in the state to the current group
+    void AddVBO( EState state, const VBO& vbo, const Colour& colour );
+    /// Upload the vertices, call once all the groups are added
+    void Bind();
+
+    /// Render the depth tested states (occluders and lines)
+    void RenderDepth();
+    /// Render the states drawn without depth test (over everything else)
+    void RenderOverlay();
+private:
+    /// Merge and upload the visible group indices if the visibility has changed
+    void Update();
+    /// Draw the state's merged indices
+    void DrawState( EState state, GLenum mode ) const;
+
+    struct Group {
+        const bool* fVisible; /// < Owned by the module
+        std::vector<GLuint> fIndices[eStateCount]; /// < Indices per state
+    };
+
+    std::vector<Group> fGroups; /// < The groups
+    std::vector<bool> fBuiltVisible; /// < Group visibility when the merged indices were built
+    bool fDirty; /// < Merged indices must be rebuilt
+    std::vector<GLuint> fStateIndices; /// < Merge workspace
+    GLuint fStateVBOID[eStateCount]; /// < Merged indices per state
+    size_t fStateCapacity[eStateCount]; /// < Bytes allocated for the merged indices
+    GLsizei fStateCount[eStateCount]; /// < Number of merged indices
+    mutable GLuint fStateVAOID[eStateCount]; /// < Vertex array objects, built on first render
+};
+
+} // namespace Viewer
+
+#endif
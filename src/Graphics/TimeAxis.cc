@@ -23,13 +23,6 @@ TimeAxis::Fill()
       const double time = static_cast<double>( fHeight - yPixel - 1 ) / static_cast<double>( fHeight ) * 500.0;
       const double scale = ScaleTime( time );
       Colour colour = GUIProperties::GetInstance().GetColourPalette().GetColour( scale );
-      for( unsigned int xPixel = 0; xPixel < fWidth; xPixel++ )
-        {
-          int pixel = ( xPixel + yPixel * fWidth ) * 4;
-          fPixels[pixel] = colour.r;
-          fPixels[pixel + 1] = colour.g;
-          fPixels[pixel + 2] = colour.b;
-          fPixels[pixel + 3] = colour.a;
-        }
+      FillRect( 0, yPixel, fWidth, 1, PackColour( colour ) );
     }
 }
@@ -9,10 +9,17 @@
 #include <Viewer/Colour.hh>
 #include <Viewer/ConfigurationTable.hh>
 #include <Viewer/VBO.hh>
+#include <Viewer/Shader3d.hh>
 
 namespace Viewer {
 
+size_t VBO::fsFrameBytes = 0;
+size_t VBO::fsLastFrameBytes = 0;
+size_t VBO::fsFrameDraws = 0;
+size_t VBO::fsLastFrameDraws = 0;
+
 VBO::VBO()
+    : fVertexCapacity( 0 ), fIndexCapacity( 0 ), fVAOID( 0 )
 {
     glGenBuffers( 1, &fVertexVBOID );
     glGenBuffers( 1, &fIndexVBOID );
@@ -20,13 +27,34 @@ VBO::VBO()
 
 void VBO::Bind()
 {
-    glBindBuffer( GL_ARRAY_BUFFER, fVertexVBOID );
-    glBufferData( GL_ARRAY_BUFFER, fVertices.size()*sizeof(struct Vertex::Data), &fVertices[0], GL_DYNAMIC_DRAW );
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+    Upload( GL_ARRAY_BUFFER, fVertexVBOID, fVertices.empty() ? NULL : &fVertices[0], fVertices.size()*sizeof(struct Vertex::Data), fVertexCapacity );
+    Upload( GL_ELEMENT_ARRAY_BUFFER, fIndexVBOID, fIndices.empty() ? NULL : &fIndices[0], fIndices.size()*sizeof(GLuint), fIndexCapacity );
+}
 
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, fIndexVBOID );
-    glBufferData( GL_ELEMENT_ARRAY_BUFFER, fIndices.size()*sizeof(unsigned short), &fIndices[0], GL_DYNAMIC_DRAW );
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+void VBO::Upload( GLenum target, GLuint bufferID, const void* data, size_t bytes, size_t& capacity )
+{
+    glBindBuffer( target, bufferID );
+    if( bytes > capacity )
+    {
+        glBufferData( target, bytes, data, GL_DYNAMIC_DRAW );
+        capacity = bytes;
+    }
+    else if( bytes > 0 )
+    {
+        // Orphan the old storage so the driver need not wait for pending draws, then update
+        glBufferData( target, capacity, NULL, GL_DYNAMIC_DRAW );
+        glBufferSubData( target, 0, bytes, data );
+    }
+    glBindBuffer( target, 0 );
+    fsFrameBytes += bytes;
+}
+
+void VBO::NewFrame()
+{
+    fsLastFrameBytes = fsFrameBytes;
+    fsFrameBytes = 0;
+    fsLastFrameDraws = fsFrameDraws;
+    fsFrameDraws = 0;
 }
 
 void VBO::AddVertex( const Vertex& v )
@@ -34,24 +62,70 @@ void VBO::AddVertex( const Vertex& v )
     fVertices.push_back(v.fData);
 }
 
-void VBO::AddIndex( const unsigned short i )
+void VBO::AddIndex( const GLuint i )
 {
     fIndices.push_back(i);
 }
 
 void VBO::Render( GLenum mode ) const
 {
-    glBindBuffer( GL_ARRAY_BUFFER, fVertexVBOID );
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, fIndexVBOID );
+    Draw( mode, fIndices.size(), fVAOID, fVertexVBOID, sizeof( struct Vertex::Data ), 3*sizeof(float), fIndexVBOID );
+}
+
+void VBO::Draw( GLenum mode, GLsizei count, GLuint& vao, GLuint colourVBOID, GLsizei colourStride, size_t colourOffset, GLuint indexVBOID, GLuint valueVBOID ) const
+{
+    if( count == 0 )
+        return;
+    fsFrameDraws++;
+    const Shader3d& shader = Shader3d::GetInstance();
+    if( shader.IsValid() )
+    {
+        if( vao == 0 )
+        {
+            // The buffer names never change, so the bindings are only set once
+            glGenVertexArrays( 1, &vao );
+            glBindVertexArray( vao );
+            glBindBuffer( GL_ARRAY_BUFFER, fVertexVBOID );
+            glEnableVertexAttribArray( Shader3d::ePosition );
+            glVertexAttribPointer( Shader3d::ePosition, 3, GL_FLOAT, GL_FALSE, sizeof( struct Vertex::Data ), 0 );
+            if( colourVBOID != 0 )
+            {
+                glBindBuffer( GL_ARRAY_BUFFER, colourVBOID );
+                glEnableVertexAttribArray( Shader3d::eColour );
+                glVertexAttribPointer( Shader3d::eColour, 4, GL_UNSIGNED_BYTE, GL_TRUE, colourStride, (const GLvoid*) colourOffset );
+            }
+            if( valueVBOID != 0 )
+            {
+                glBindBuffer( GL_ARRAY_BUFFER, valueVBOID );
+                glEnableVertexAttribArray( Shader3d::eValue );
+                glVertexAttribPointer( Shader3d::eValue, 1, GL_FLOAT, GL_FALSE, 0, 0 );
+            }
+            glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, indexVBOID );
+            glBindVertexArray( 0 );
+            glBindBuffer( GL_ARRAY_BUFFER, 0 );
+            glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        }
+        shader.Use( valueVBOID != 0 ? Shader3d::eValueProgram : Shader3d::eColourProgram );
+        glBindVertexArray( vao );
+        glDrawElements( mode, count, GL_UNSIGNED_INT, 0 );
+        glBindVertexArray( 0 );
+        shader.Release();
+        return;
+    }
 
     glDisableClientState( GL_TEXTURE_COORD_ARRAY );
     glEnableClientState( GL_VERTEX_ARRAY );
-    glEnableClientState( GL_COLOR_ARRAY );
-
+    glBindBuffer( GL_ARRAY_BUFFER, fVertexVBOID );
     glVertexPointer( 3, GL_FLOAT, sizeof( struct Vertex::Data ), 0 );
-    glColorPointer( 4, GL_FLOAT, sizeof( struct Vertex::Data ), (const GLvoid*) (3*sizeof(float)));
+    if( colourVBOID != 0 )
+    {
+        glEnableClientState( GL_COLOR_ARRAY );
+        glBindBuffer( GL_ARRAY_BUFFER, colourVBOID );
+        glColorPointer( 4, GL_UNSIGNED_BYTE, colourStride, (const GLvoid*) colourOffset );
+    }
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, indexVBOID );
 
-    glDrawElements( mode, fIndices.size(), GL_UNSIGNED_SHORT, 0 );
+    glDrawElements( mode, count, GL_UNSIGNED_INT, 0 );
     
     glDisableClientState( GL_VERTEX_ARRAY );
     glDisableClientState( GL_COLOR_ARRAY );
@@ -88,7 +162,7 @@ void VBO::Load( const ConfigurationTable* configTable )
     for( int i = 0; i < configTable->GetI("num_indices"); i++ )
     {
         std::stringstream ss; ss << i;
-        AddIndex( (unsigned short) indices->GetI( "i" + ss.str() ) ); 
+        AddIndex( (GLuint) indices->GetI( "i" + ss.str() ) ); 
     }
     
     Bind();
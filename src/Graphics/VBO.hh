@@ -14,7 +14,14 @@
 ///          10 times performance gain over using vertex arrays, and 100s
 ///          time perfomrance gain over using immediate mode rendering.
 ///          Should always be used to store and render large amounts of
-///          3D data. Creates dependence on OpenGL > version 1.5 (2002?) . \n
+///          3D data. Creates dependence on OpenGL > version 1.5 (2002?) .
+///          Indices are 32 bit, so no vertex count limit. Bind reuses the
+///          GPU storage (orphaned, then updated) unless the data has
+///          grown. The bytes uploaded and the draw calls made by all VBOs
+///          are counted per frame.
+///          If Shader3d is valid the attribute state is held in a vertex
+///          array object set up on the first Render, so each draw is a
+///          bind and a glDrawElements. \n
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -34,19 +41,52 @@ public:
     VBO();
     void Bind();
     void AddVertex( const Vertex& v );
-    void AddIndex( const unsigned short i );
+    void AddIndex( const GLuint i );
     void Render( GLenum mode ) const;
     void Clear();
 
     void Load( const ConfigurationTable* configTable );
     void Save( ConfigurationTable* configTable ) const;
 
+    /// Called on new frame, resets the upload statistics
+    static void NewFrame();
+    /// Return the bytes uploaded by all VBOs in the last frame
+    static size_t GetFrameUploadBytes() { return fsLastFrameBytes; }
+    /// Return the draw calls made by all VBOs in the last frame
+    static size_t GetFrameDrawCalls() { return fsLastFrameDraws; }
+
     std::vector<struct Vertex::Data> fVertices;
-    std::vector<unsigned short> fIndices;
+    std::vector<GLuint> fIndices;
 
     GLuint fVertexVBOID;
     GLuint fIndexVBOID;
+protected:
+    /// Draw count indices, positions from the vertices and colours from the colour buffer (packed RGBA
+    /// with the stride and offset, 0 buffer for a constant colour), vao is built on first use. If a
+    /// value buffer (float per vertex) is given the colours come from the Shader3d value program instead
+    void Draw( GLenum mode,
+               GLsizei count,
+               GLuint& vao,
+               GLuint colourVBOID,
+               GLsizei colourStride,
+               size_t colourOffset,
+               GLuint indexVBOID,
+               GLuint valueVBOID = 0 ) const;
+    /// Upload the data to the buffer, reusing the storage if it fits in the capacity (bytes allocated)
+    static void Upload( GLenum target,
+                        GLuint bufferID,
+                        const void* data,
+                        size_t bytes,
+                        size_t& capacity );
     
+    size_t fVertexCapacity; /// < Bytes allocated for the vertices
+    size_t fIndexCapacity; /// < Bytes allocated for the indices
+    mutable GLuint fVAOID; /// < Vertex array object, 0 until first Render
+
+    static size_t fsFrameBytes; /// < Bytes uploaded so far this frame
+    static size_t fsLastFrameBytes; /// < Bytes uploaded in the last frame
+    static size_t fsFrameDraws; /// < Draw calls made so far this frame
+    static size_t fsLastFrameDraws; /// < Draw calls made in the last frame
 };
 
 } // namespace Viewer
@@ -10,8 +10,8 @@
 ///
 /// \detail  Stores the data needed to render a vertex in a struct, so
 ///          that the absolute offsets between fields can be easily 
-///          calculated. Padding is necessary to align the vertex data
-///          struct to 32 bytes to increase performance. Each vertex
+///          calculated. The colour is packed into 4 bytes, so the vertex
+///          data struct is 16 bytes (aligned) with no padding. Each vertex
 ///          specifies a position in 3D space and a colour. Decided not
 ///          to include normal vertex or texture coordinates due to
 ///          symbolic representation of most objects. \n
@@ -21,6 +21,8 @@
 #ifndef __Viewer_Vertex__
 #define __Viewer_Vertex__
 
+#include <SFML/Config.hpp>
+
 class TVector3;
 
 namespace Viewer {
@@ -31,8 +33,7 @@ public:
 
     struct Data {
         float x, y, z;
-        float r, g, b, a;
-        float padding;
+        sf::Uint8 r, g, b, a;
     };  // struct Data
 
     struct Data fData;
@@ -0,0 +1,31 @@
+#include <Viewer/Condition.hh>
+#include <Viewer/Mutex.hh>
+using namespace Viewer;
+
+Condition::Condition()
+{
+  pthread_cond_init( &fCondition, NULL );
+}
+
+Condition::~Condition()
+{
+  pthread_cond_destroy( &fCondition );
+}
+
+void
+Condition::Wait( Mutex& mutex )
+{
+  pthread_cond_wait( &fCondition, &mutex.fMutex );
+}
+
+void
+Condition::Signal()
+{
+  pthread_cond_signal( &fCondition );
+}
+
+void
+Condition::Broadcast()
+{
+  pthread_cond_broadcast( &fCondition );
+}
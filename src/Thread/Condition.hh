@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::Condition
+///
+/// \brief   Condition variable class
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Condition variable, a thread waits (holding the mutex) until
+///          another signals that the guarded state has changed. Waits may
+///          wake spuriously, so always wait in a loop checking the state.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef Condition_hh
+#define Condition_hh
+
+#include <pthread.h>
+
+namespace Viewer
+{
+  class Mutex;
+
+class Condition
+{
+public:
+  Condition();
+  ~Condition();
+
+  /// Release the mutex (must be locked) and wait, the mutex is relocked before returning
+  void
+  Wait( Mutex& mutex );
+
+  /// Wake one waiting thread
+  void
+  Signal();
+
+  /// Wake all waiting threads
+  void
+  Broadcast();
+private:
+  pthread_cond_t fCondition; /// < Condition variable itself
+};
+
+} // ::Viewer
+
+#endif
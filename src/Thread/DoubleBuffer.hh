@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::DoubleBuffer
+///
+/// \brief   Hands products from a producer thread to a consumer thread
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  The producer fills the back slot and publishes it, which swaps
+///          it with the front slot. The consumer acquires the front slot
+///          by swapping it with its own (displayed) product, so neither
+///          side ever copies or waits on the other for long. An unconsumed
+///          product is replaced by a newer one. The product type must
+///          have a cheap swap member function, e.g. be built of vectors.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_DoubleBuffer__
+#define __Viewer_DoubleBuffer__
+
+#include <Viewer/Mutex.hh>
+
+namespace Viewer
+{
+
+template<class T>
+class DoubleBuffer
+{
+public:
+  DoubleBuffer() : fReady( false ) { }
+
+  /// Return the back slot to fill, called by the producer ONLY
+  T& GetBack() { return fBack; }
+  /// Publish the back slot, called by the producer ONLY
+  void Publish();
+  /// Swap the latest published product into product, returns false if none is new
+  bool Acquire( T& product );
+private:
+  Mutex fLock; /// < Guards the front slot and ready flag
+  T fBack; /// < Slot being filled by the producer
+  T fFront; /// < Last published product
+  bool fReady; /// < fFront has not been acquired
+};
+
+template<class T>
+void
+DoubleBuffer<T>::Publish()
+{
+  Lock lock( fLock );
+  fFront.swap( fBack );
+  fReady = true;
+}
+
+template<class T>
+bool
+DoubleBuffer<T>::Acquire( T& product )
+{
+  Lock lock( fLock );
+  if( !fReady )
+    return false;
+  product.swap( fFront );
+  fReady = false;
+  return true;
+}
+
+} //::Viewer
+
+#endif
@@ -0,0 +1,56 @@
+#include <SFML/System/Sleep.hpp>
+
+#include <Viewer/GenerateEventThread.hh>
+#include <Viewer/EventGenerator.hh>
+#include <Viewer/DataStore.hh>
+#include <Viewer/Semaphore.hh>
+using namespace Viewer;
+#include <Viewer/RIDS/Event.hh>
+
+GenerateEventThread::GenerateEventThread( EventGenerator& generator,
+                                          int events,
+                                          Semaphore& semaphore )
+  : fGenerator( generator ), fPending( NULL ), fEvents( events ), fAdded( 0 ), fSemaphore( semaphore )
+{
+
+}
+
+GenerateEventThread::~GenerateEventThread()
+{
+  delete fPending;
+}
+
+void
+GenerateEventThread::Run()
+{
+  if( fAdded >= fEvents )
+    {
+      Kill();
+      return;
+    }
+  if( fPending == NULL )
+    {
+      const double rate = fGenerator.GetSettings().fRate;
+      if( fAdded == 0 )
+        fClock.restart();
+      else if( rate > 0.0 )
+        {
+          const double due = static_cast<double>( fAdded ) / rate - fClock.getElapsedTime().asSeconds();
+          if( due > 0.0 )
+            {
+              sf::sleep( sf::seconds( static_cast<float>( due ) ) );
+              return;
+            }
+        }
+      fPending = fGenerator.Generate();
+    }
+  if( !DataStore::GetInstance().AddEvent( fPending ) )
+    {
+      sf::sleep( sf::milliseconds( 1 ) ); // Input buffer is full, the reader is behind
+      return;
+    }
+  fPending = NULL;
+  fAdded++;
+  if( fAdded == 1 )
+    fSemaphore.Signal();
+}
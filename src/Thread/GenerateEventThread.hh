@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////
+/// \class GenerateEventThread
+///
+/// \brief   Adds synthetic events to the DataStore
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Stands in for the loader threads in the benchmarks. Adds the
+///          requested number of events from an EventGenerator to the
+///          DataStore at the generator's rate (as fast as possible if the
+///          rate is zero or less), retrying if the input buffer is full.
+///          Signals the semaphore once the first event is added.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_GenerateEventThread__
+#define __Viewer_GenerateEventThread__
+
+#include <SFML/System/Clock.hpp>
+
+#include <Viewer/Thread.hh>
+
+namespace Viewer
+{
+  class Semaphore;
+  class EventGenerator;
+namespace RIDS
+{
+  class Event;
+}
+
+class GenerateEventThread : public Thread
+{
+public:
+  /// Construct the thread, requires the generator, number of events to add and a semaphore to signal data has arrived.
+  GenerateEventThread( EventGenerator& generator,
+                       int events,
+                       Semaphore& semaphore );
+  /// Destructor, deletes any event not yet added
+  virtual ~GenerateEventThread();
+  /// Run function, called by the thread
+  virtual void Run();
+private:
+  EventGenerator& fGenerator; /// < The event generator
+  RIDS::Event* fPending; /// < Event generated but not yet added, NULL if none
+  sf::Clock fClock; /// < Time since the first event was generated
+  int fEvents; /// < Number of events to add
+  int fAdded; /// < Number of events added
+  Semaphore& fSemaphore; /// < The semaphore to signal events have arrived
+};
+
+} //::Viewer
+
+#endif
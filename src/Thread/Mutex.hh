@@ -21,6 +21,7 @@
 
 namespace Viewer
 {
+  class Condition;
 
 class Mutex
 {
@@ -37,6 +38,7 @@ public:
   void
   Unlock();
 private:
+  friend class Condition;
   pthread_mutex_t fMutex; /// <Mutex lock itself
 };
 
@@ -0,0 +1,253 @@
+#include <unistd.h>
+
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/Scheduler.hh>
+#include <Viewer/WorkerThread.hh>
+using namespace Viewer;
+
+const long kMaxThreads = 16; // More threads than this contend rather than help
+
+Scheduler::Scheduler()
+  : fQueuedCount( 0 ), fNextWorker( 0 ), fStartedWorkers( 0 ), fStarted( false ), fStopping( false ), fTimingHook( NULL )
+{
+  pthread_key_create( &fWorkerKey, NULL );
+}
+
+Scheduler::~Scheduler()
+{
+  {
+    Lock lock( fStateLock );
+    fStopping = true;
+    for( vector<WorkerThread*>::iterator iTer = fThreads.begin(); iTer != fThreads.end(); iTer++ )
+      (*iTer)->Kill();
+    fQueued.Broadcast(); // Wake the workers so that they can stop
+  }
+  for( vector<WorkerThread*>::iterator iTer = fThreads.begin(); iTer != fThreads.end(); iTer++ )
+    {
+      (*iTer)->Wait();
+      delete *iTer;
+    }
+  for( vector<Worker*>::iterator iTer = fWorkers.begin(); iTer != fWorkers.end(); iTer++ )
+    delete *iTer;
+  pthread_key_delete( fWorkerKey );
+}
+
+void
+Scheduler::Submit( Task& task )
+{
+  Lock lock( fStateLock );
+  SubmitLocked( task );
+}
+
+bool
+Scheduler::Cancel( Task& task )
+{
+  Lock lock( fStateLock );
+  task.fResubmit = false;
+  const bool cancelled = task.fState == Task::eQueued;
+  if( cancelled )
+    {
+      task.fState = Task::eCancelled;
+      for( vector<Worker*>::iterator iTer = fWorkers.begin(); iTer != fWorkers.end(); iTer++ )
+        {
+          Lock workerLock( (*iTer)->fLock );
+          deque<Task*>::iterator found = find( (*iTer)->fTasks.begin(), (*iTer)->fTasks.end(), &task );
+          if( found != (*iTer)->fTasks.end() )
+            {
+              (*iTer)->fTasks.erase( found );
+              fQueuedCount--;
+              task.fHeld = false;
+              break;
+            }
+        }
+    }
+  // Otherwise it is running, or taken and about to see it is cancelled
+  while( task.fHeld )
+    fStateChanged.Wait( fStateLock );
+  return cancelled;
+}
+
+void
+Scheduler::Wait( Task& task )
+{
+  for( ;; )
+    {
+      {
+        Lock lock( fStateLock );
+        if( !task.fHeld )
+          return;
+      }
+      if( RunOne() )
+        continue; // Help rather than idle
+      Lock lock( fStateLock );
+      if( task.fHeld && fQueuedCount == 0 )
+        fStateChanged.Wait( fStateLock );
+    }
+}
+
+bool
+Scheduler::IsFinished( Task& task )
+{
+  Lock lock( fStateLock );
+  return !task.fHeld;
+}
+
+void
+Scheduler::SetTimingHook( TimingHook hook )
+{
+  Lock lock( fStateLock );
+  fTimingHook = hook;
+}
+
+void
+Scheduler::RunWorker()
+{
+  int worker = GetWorkerIndex();
+  if( worker < 0 )
+    {
+      Lock lock( fStateLock );
+      worker = fStartedWorkers++;
+      pthread_setspecific( fWorkerKey, reinterpret_cast<void*>( static_cast<size_t>( worker + 1 ) ) );
+    }
+  if( RunOne() )
+    return;
+  Lock lock( fStateLock );
+  while( fQueuedCount == 0 && !fStopping )
+    fQueued.Wait( fStateLock );
+}
+
+void
+Scheduler::Start()
+{
+  fStarted = true;
+  const long cores = sysconf( _SC_NPROCESSORS_ONLN );
+  const long workers = max( min( cores, kMaxThreads ) - 1, 1L );
+  for( long iWorker = 0; iWorker < workers; iWorker++ )
+    fWorkers.push_back( new Worker() );
+  for( long iWorker = 0; iWorker < workers; iWorker++ )
+    {
+      fThreads.push_back( new WorkerThread() );
+      fThreads.back()->Start();
+    }
+}
+
+int
+Scheduler::GetWorkerIndex() const
+{
+  return static_cast<int>( reinterpret_cast<size_t>( pthread_getspecific( fWorkerKey ) ) ) - 1;
+}
+
+Scheduler::Task*
+Scheduler::Take( int worker )
+{
+  Task* task = NULL;
+  if( worker >= 0 )
+    {
+      Lock lock( fWorkers[worker]->fLock );
+      if( !fWorkers[worker]->fTasks.empty() )
+        {
+          task = fWorkers[worker]->fTasks.back();
+          fWorkers[worker]->fTasks.pop_back();
+        }
+    }
+  const size_t workers = fWorkers.size();
+  const size_t first = worker >= 0 ? worker + 1 : 0;
+  for( size_t iWorker = 0; task == NULL && iWorker < workers; iWorker++ )
+    {
+      Worker& victim = *fWorkers[( first + iWorker ) % workers];
+      Lock lock( victim.fLock );
+      if( !victim.fTasks.empty() )
+        {
+          task = victim.fTasks.front();
+          victim.fTasks.pop_front();
+        }
+    }
+  if( task != NULL )
+    {
+      Lock lock( fStateLock );
+      fQueuedCount--;
+    }
+  return task;
+}
+
+void
+Scheduler::SubmitLocked( Task& task )
+{
+  if( !fStarted )
+    Start();
+  if( task.fState == Task::eQueued )
+    return; // Will process the newest inputs when it runs
+  if( task.fState == Task::eRunning )
+    {
+      task.fResubmit = true;
+      return;
+    }
+  task.fState = Task::eQueued;
+  task.fHeld = true;
+  Queue( task );
+}
+
+void
+Scheduler::Queue( Task& task )
+{
+  int worker = GetWorkerIndex();
+  if( worker < 0 )
+    worker = fNextWorker++ % fWorkers.size();
+  {
+    Lock lock( fWorkers[worker]->fLock );
+    fWorkers[worker]->fTasks.push_back( &task );
+  }
+  fQueuedCount++;
+  fQueued.Signal();
+}
+
+bool
+Scheduler::RunOne()
+{
+  const int worker = GetWorkerIndex();
+  Task* task = Take( worker );
+  if( task == NULL )
+    return false;
+  Run( *task, worker );
+  return true;
+}
+
+void
+Scheduler::Run( Task& task,
+                int worker )
+{
+  TimingHook timingHook = NULL;
+  {
+    Lock lock( fStateLock );
+    if( task.fState == Task::eCancelled )
+      {
+        task.fHeld = false;
+        fStateChanged.Broadcast();
+        return;
+      }
+    task.fState = Task::eRunning;
+    timingHook = fTimingHook;
+  }
+  task.fStartTime = GetTime();
+  task.Execute();
+  task.fEndTime = GetTime();
+  if( timingHook != NULL )
+    timingHook( task, task.fStartTime, task.fEndTime, worker );
+  Lock lock( fStateLock );
+  if( task.fResubmit )
+    {
+      // Submitted whilst running, run again with the newest inputs
+      task.fResubmit = false;
+      task.fState = Task::eQueued;
+      Queue( task );
+      return;
+    }
+  task.fState = Task::eFinished;
+  task.fHeld = false;
+  Task* continuation = task.fContinuation; // The task may be deleted once released
+  fStateChanged.Broadcast();
+  if( continuation != NULL )
+    SubmitLocked( *continuation );
+}
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::Scheduler
+///
+/// \brief   Work stealing task scheduler, shared by all the viewer's work
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  A bounded number of WorkerThreads (one per core less the main
+///          thread) run the submitted tasks. Each worker has its own task
+///          queue, tasks submitted from a worker go onto its queue and are
+///          run newest first, tasks submitted from elsewhere are shared
+///          round robin. An idle worker steals the oldest task from the
+///          other workers. A task acts as its own future, Wait blocks
+///          (running other tasks meanwhile) until it has finished and the
+///          results can then be read from the derived task. A continuation
+///          can be set with Then, it is submitted once the task finishes.
+///          Cancel stops a task that has not yet started. Submitting a
+///          queued task does nothing, it will process the newest inputs,
+///          submitting a running task runs it once more after it finishes.
+///          Hence a task never runs concurrently with itself. The owner must
+///          Wait or Cancel before deleting a submitted task. Each task run
+///          is timed and passed to the timing hook, if set. Long lived
+///          blocking work (e.g. reading a file) should have its own Thread
+///          instead. This is a singleton class.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_Scheduler__
+#define __Viewer_Scheduler__
+
+#include <SFML/System/Clock.hpp>
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+
+#include <Viewer/Mutex.hh>
+#include <Viewer/Condition.hh>
+
+namespace Viewer
+{
+  class WorkerThread;
+
+class Scheduler
+{
+public:
+  /// A unit of work, derive and implement Execute
+  class Task
+  {
+  public:
+    /// Name must be a string literal (or otherwise outlive the task)
+    Task( const char* name ) : fName( name ), fContinuation( NULL ), fState( eIdle ),
+                                      fHeld( false ), fResubmit( false ), fStartTime( 0.0 ), fEndTime( 0.0 ) { }
+    virtual ~Task() { }
+    /// Do the work, called on a worker (or a thread waiting on the scheduler)
+    virtual void Execute() = 0;
+    /// Set the task to submit once this task finishes (not if cancelled), NULL for none
+    void Then( Task* continuation ) { fContinuation = continuation; }
+    /// Return the task name, used for timing
+    const char* GetName() const { return fName; }
+  private:
+    friend class Scheduler;
+    enum EState { eIdle, eQueued, eRunning, eFinished, eCancelled };
+
+    const char* fName; /// < Task name
+    Task* fContinuation; /// < Submitted when finished
+    EState fState; /// < Current state, guarded by the scheduler
+    bool fHeld; /// < The scheduler holds a reference, guarded by the scheduler
+    bool fResubmit; /// < Submitted whilst running, guarded by the scheduler
+    double fStartTime; /// < Time the last run started
+    double fEndTime; /// < Time the last run ended
+  };
+  /// Called after each task run with the task, start and end times in seconds and the worker index (-1 if not a worker)
+  typedef void (*TimingHook)( const Task& task, double start, double end, int worker );
+
+  /// Singleton class instance
+  static Scheduler& GetInstance();
+  ~Scheduler();
+
+  /// Queue the task, see detail for submitting an already submitted task
+  void Submit( Task& task );
+  /// Cancel the task if not yet started and wait for it to be released, returns true if cancelled
+  bool Cancel( Task& task );
+  /// Wait until the task is finished or cancelled, running other tasks meanwhile
+  void Wait( Task& task );
+  /// Return true if the task is not queued or running
+  bool IsFinished( Task& task );
+  /// Set the timing hook, NULL for none, thread safe
+  void SetTimingHook( TimingHook hook );
+  /// Return the time in seconds since the scheduler started, the task timing base
+  double GetTime() const { return fClock.getElapsedTime().asSeconds(); }
+  /// Return the number of workers
+  size_t GetWorkerCount() const { return fWorkers.size(); }
+
+  /// Run tasks until stopped. Called by the WorkerThread ONLY
+  void RunWorker();
+private:
+  /// A worker's task queue
+  struct Worker
+  {
+    Mutex fLock; /// < Guards the tasks
+    std::deque<Task*> fTasks; /// < Queued tasks, newest at the back
+  };
+
+  /// Start the workers, one per core less the main thread
+  void Start();
+  /// Return the calling thread's worker index, -1 if not a worker
+  int GetWorkerIndex() const;
+  /// Take a task, own queue newest first then steal oldest from the others, NULL if none
+  Task* Take( int worker );
+  /// Submit the task, must hold the state lock
+  void SubmitLocked( Task& task );
+  /// Push the task onto a worker queue and wake a worker, must hold the state lock
+  void Queue( Task& task );
+  /// Take and run a task, returns false if there were none
+  bool RunOne();
+  /// Run the task, it has been taken from a queue
+  void Run( Task& task,
+            int worker );
+
+  std::vector<Worker*> fWorkers; /// < Worker queues
+  std::vector<WorkerThread*> fThreads; /// < Worker threads
+  pthread_key_t fWorkerKey; /// < Thread specific worker index plus one
+  Mutex fStateLock; /// < Guards the task states and everything below
+  Condition fStateChanged; /// < Broadcast when a task is released
+  Condition fQueued; /// < Signalled when a task is queued
+  size_t fQueuedCount; /// < Tasks in the worker queues
+  size_t fNextWorker; /// < Worker queue for the next task submitted from outside
+  int fStartedWorkers; /// < Workers that have claimed an index
+  bool fStarted; /// < Start has been called
+  bool fStopping; /// < The workers should stop
+  TimingHook fTimingHook; /// < Task timing hook, NULL if none, guarded by fStateLock
+  sf::Clock fClock; /// < Timing base
+
+  /// Prevent usage of methods below
+  Scheduler();
+  Scheduler( Scheduler& );
+  void operator=( Scheduler& );
+};
+
+/// Task that calls a member function of its owner
+template<class T>
+class MethodTask : public Scheduler::Task
+{
+public:
+  MethodTask( const char* name,
+              T& owner,
+              void (T::*method)() ) : Scheduler::Task( name ), fOwner( owner ), fMethod( method ) { }
+  virtual void Execute() { (fOwner.*fMethod)(); }
+private:
+  T& fOwner; /// < Object to call
+  void (T::*fMethod)(); /// < Member function to call
+};
+
+inline Scheduler&
+Scheduler::GetInstance()
+{
+  static Scheduler scheduler;
+  return scheduler;
+}
+
+} //::Viewer
+
+#endif
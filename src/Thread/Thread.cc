@@ -4,6 +4,12 @@ using namespace Viewer;
 Thread::Thread()
 {
   fRun = true;
+}
+
+void
+Thread::Start()
+{
+  // Not in the constructor, the thread would call Run before the derived class is constructed
   pthread_create( &fPThread, NULL, Thread::PosixCaller, reinterpret_cast<void*>( this ) );
 }
 
@@ -23,16 +29,24 @@ Thread::PosixCaller( void* arg )
 void
 Thread::KillAndWait()
 {
-  fRun = false;
+  Kill();
   Wait();
 }
 
 void
 Thread::Kill()
 {
+  Lock lock( fRunLock );
   fRun = false;
 }
 
+bool
+Thread::IsRunning()
+{
+  Lock lock( fRunLock );
+  return fRun;
+}
+
 void
 Thread::Wait()
 {
@@ -43,7 +57,7 @@ void
 Thread::RunT()
 {
   Initialise();
-  while( fRun )
+  while( IsRunning() )
     Run();
   pthread_exit(NULL);
 }
@@ -9,7 +9,8 @@
 ///     04/11 : P.Jones - First Revision, new file. \n
 ///
 /// \detail  All threads must derive from this, these are basically the
-///          same as sfml threads/mutexes but have a trylock.
+///          same as sfml threads/mutexes but have a trylock. Call Start
+///          once constructed, the thread then calls Run until Killed.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -19,6 +20,8 @@
 
 #include <pthread.h>
 
+#include <Viewer/Mutex.hh>
+
 namespace Viewer
 {
 
@@ -27,7 +30,11 @@ class Thread
 public:
   Thread(); 
 
-  ~Thread();
+  virtual ~Thread();
+
+  /// Start the thread, must be called after construction (not in a constructor)
+  void
+  Start();
 
   void
   Wait();
@@ -52,7 +59,11 @@ protected:
 private:
   static void* 
   PosixCaller( void* arg );
+  /// Return true if the thread should keep running
+  bool
+  IsRunning();
 
+  Mutex fRunLock; /// <Guards fRun, it is set from other threads.
   bool fRun; /// <If false then thread stops.
   pthread_t fPThread; /// <Posix thread handle for this...
 };
@@ -0,0 +1,9 @@
+#include <Viewer/WorkerThread.hh>
+#include <Viewer/Scheduler.hh>
+using namespace Viewer;
+
+void
+WorkerThread::Run()
+{
+  Scheduler::GetInstance().RunWorker();
+}
@@ -0,0 +1,36 @@
+////////////////////////////////////////////////////////////////////////
+/// \class WorkerThread
+///
+/// \brief Runs the Scheduler tasks
+///
+/// \author agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail Started by the Scheduler on first use, each run takes and runs
+///         a task, or blocks until one is queued.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_WorkerThread__
+#define __Viewer_WorkerThread__
+
+#include <Viewer/Thread.hh>
+
+namespace Viewer
+{
+
+class WorkerThread : public Thread
+{
+public:
+  WorkerThread() { }
+  virtual ~WorkerThread() { }
+
+  virtual void
+  Run();
+};
+
+} //::Viewer
+
+#endif
@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <fstream>
+#include <map>
+using namespace std;
+
+#include <Viewer/Profiler.hh>
+using namespace Viewer;
+
+const size_t kRingSize = 16384; // Records kept per thread, several seconds of frames
+
+namespace
+{
+/// Orders stats by the total duration, largest first
+bool
+LargerTotal( const Profiler::Stat& lhs,
+             const Profiler::Stat& rhs )
+{
+  return lhs.fTotal > rhs.fTotal;
+}
+
+/// Return the duration at the fraction (0 to 1) of the sorted durations
+double
+Percentile( const vector<double>& sorted,
+            double fraction )
+{
+  const size_t index = static_cast<size_t>( fraction * ( sorted.size() - 1 ) + 0.5 );
+  return sorted[index];
+}
+}
+
+Profiler::Profiler()
+{
+  pthread_key_create( &fRingKey, NULL );
+  Scheduler& scheduler = Scheduler::GetInstance();
+  fSchedulerOffset = Now() - scheduler.GetTime();
+  scheduler.SetTimingHook( &Profiler::TaskHook );
+}
+
+const char*
+Profiler::Intern( const string& name )
+{
+  Lock lock( fLock );
+  return fNames.insert( name ).first->c_str();
+}
+
+void
+Profiler::Record( const char* name,
+                  double start,
+                  double end )
+{
+  Entry entry;
+  entry.fName = name;
+  entry.fStart = start;
+  entry.fEnd = end;
+  entry.fValue = 0.0;
+  entry.fCounter = false;
+  Add( entry );
+}
+
+void
+Profiler::SetCounter( const char* name,
+                      double value )
+{
+  Entry entry;
+  entry.fName = name;
+  entry.fStart = entry.fEnd = Now();
+  entry.fValue = value;
+  entry.fCounter = true;
+  Add( entry );
+}
+
+void
+Profiler::GetStats( double window,
+                    vector<Stat>& stats )
+{
+  vector< pair<int, Entry> > entries;
+  Collect( entries );
+  const double since = Now() - window;
+  map< string, vector<double> > durations; // By value, the same literal may have several addresses
+  for( vector< pair<int, Entry> >::const_iterator iTer = entries.begin(); iTer != entries.end(); iTer++ )
+    if( !iTer->second.fCounter && iTer->second.fEnd >= since )
+      durations[iTer->second.fName].push_back( iTer->second.fEnd - iTer->second.fStart );
+  stats.clear();
+  for( map< string, vector<double> >::iterator iTer = durations.begin(); iTer != durations.end(); iTer++ )
+    {
+      vector<double>& sorted = iTer->second;
+      sort( sorted.begin(), sorted.end() );
+      Stat stat;
+      stat.fName = iTer->first;
+      stat.fCount = sorted.size();
+      stat.fTotal = 0.0;
+      for( vector<double>::const_iterator iDuration = sorted.begin(); iDuration != sorted.end(); iDuration++ )
+        stat.fTotal += *iDuration;
+      stat.fMedian = Percentile( sorted, 0.5 );
+      stat.fP95 = Percentile( sorted, 0.95 );
+      stat.fMax = sorted.back();
+      stats.push_back( stat );
+    }
+  sort( stats.begin(), stats.end(), LargerTotal );
+}
+
+void
+Profiler::GetCounters( double window,
+                       vector<Counter>& counters )
+{
+  vector< pair<int, Entry> > entries;
+  Collect( entries );
+  const double since = Now() - window;
+  map< string, vector<const Entry*> > samples; // By value, as for GetStats
+  for( vector< pair<int, Entry> >::const_iterator iTer = entries.begin(); iTer != entries.end(); iTer++ )
+    if( iTer->second.fCounter && iTer->second.fEnd >= since )
+      samples[iTer->second.fName].push_back( &iTer->second );
+  counters.clear();
+  for( map< string, vector<const Entry*> >::const_iterator iTer = samples.begin(); iTer != samples.end(); iTer++ )
+    {
+      Counter counter;
+      counter.fName = iTer->first;
+      counter.fLast = iTer->second.front()->fValue;
+      double lastTime = iTer->second.front()->fEnd;
+      double total = 0.0;
+      counter.fMax = iTer->second.front()->fValue;
+      for( vector<const Entry*>::const_iterator iSample = iTer->second.begin(); iSample != iTer->second.end(); iSample++ )
+        {
+          total += (*iSample)->fValue;
+          counter.fMax = max( counter.fMax, (*iSample)->fValue );
+          if( (*iSample)->fEnd >= lastTime ) // Entries are ordered per thread only
+            {
+              lastTime = (*iSample)->fEnd;
+              counter.fLast = (*iSample)->fValue;
+            }
+        }
+      counter.fMean = total / iTer->second.size();
+      counters.push_back( counter );
+    }
+}
+
+bool
+Profiler::WriteChromeTrace( const string& fileName )
+{
+  vector< pair<int, Entry> > entries;
+  Collect( entries );
+  ofstream trace( fileName.c_str() );
+  if( !trace.is_open() )
+    return false;
+  trace << fixed;
+  trace.precision( 3 );
+  trace << "{\"traceEvents\":[" << endl;
+  for( vector< pair<int, Entry> >::const_iterator iTer = entries.begin(); iTer != entries.end(); iTer++ )
+    {
+      // Complete or counter events, times in microseconds. Names are code identifiers, no escaping is needed
+      trace << ( iTer == entries.begin() ? "" : ",\n" );
+      if( iTer->second.fCounter )
+        trace << "{\"name\":\"" << iTer->second.fName << "\",\"ph\":\"C\",\"pid\":1,\"ts\":" << iTer->second.fEnd * 1.0e6
+              << ",\"args\":{\"value\":" << iTer->second.fValue << "}}";
+      else
+        trace << "{\"name\":\"" << iTer->second.fName << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << iTer->first
+              << ",\"ts\":" << iTer->second.fStart * 1.0e6 << ",\"dur\":" << ( iTer->second.fEnd - iTer->second.fStart ) * 1.0e6 << "}";
+    }
+  trace << endl << "]}" << endl;
+  return trace.good();
+}
+
+void
+Profiler::Add( const Entry& entry )
+{
+  Ring& ring = GetRing();
+  Lock lock( ring.fLock );
+  ring.fEntries[ring.fNext] = entry;
+  ring.fNext = ( ring.fNext + 1 ) % ring.fEntries.size();
+  ring.fCount = min( ring.fCount + 1, ring.fEntries.size() );
+}
+
+void
+Profiler::Collect( vector< pair<int, Entry> >& entries )
+{
+  vector<Ring*> rings;
+  {
+    Lock lock( fLock );
+    rings = fRings;
+  }
+  for( vector<Ring*>::iterator iTer = rings.begin(); iTer != rings.end(); iTer++ )
+    {
+      Ring& ring = **iTer;
+      Lock lock( ring.fLock );
+      const size_t size = ring.fEntries.size();
+      const size_t first = ( ring.fNext + size - ring.fCount ) % size; // Oldest valid record
+      for( size_t iEntry = 0; iEntry < ring.fCount; iEntry++ )
+        entries.push_back( pair<int, Entry>( ring.fThread, ring.fEntries[( first + iEntry ) % size] ) );
+    }
+}
+
+Profiler::Ring&
+Profiler::GetRing()
+{
+  Ring* ring = reinterpret_cast<Ring*>( pthread_getspecific( fRingKey ) );
+  if( ring != NULL )
+    return *ring;
+  ring = new Ring();
+  ring->fEntries.resize( kRingSize );
+  ring->fNext = 0;
+  ring->fCount = 0;
+  {
+    Lock lock( fLock );
+    ring->fThread = fRings.size();
+    fRings.push_back( ring );
+  }
+  pthread_setspecific( fRingKey, ring );
+  return *ring;
+}
+
+void
+Profiler::TaskHook( const Scheduler::Task& task,
+                    double start,
+                    double end,
+                    int )
+{
+  Profiler& profiler = Profiler::GetInstance();
+  profiler.Record( task.GetName(), start + profiler.fSchedulerOffset, end + profiler.fSchedulerOffset );
+}
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::Profiler
+///
+/// \brief   Low overhead scoped timers, for finding where frame time goes
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  A Scope records its name, start and end time when destroyed
+///          into a ring buffer owned by the calling thread, so recording
+///          never contends with other threads. The rings hold the last
+///          kRingSize records per thread. GetStats summarises the records
+///          in a recent window per name (count and duration percentiles),
+///          WriteChromeTrace dumps every record as Chrome trace JSON (load
+///          in chrome://tracing). The Scheduler task runs are recorded by
+///          name. SetCounter records a sampled value (e.g. draw calls per
+///          frame), summarised by GetCounters. Names must be string
+///          literals, or built once and copied via Intern, as recording
+///          only stores the pointer. This is a singleton class.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_Profiler__
+#define __Viewer_Profiler__
+
+#include <SFML/System/Clock.hpp>
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include <Viewer/Mutex.hh>
+#include <Viewer/Scheduler.hh>
+
+namespace Viewer
+{
+
+class Profiler
+{
+public:
+  /// Records the time from construction to destruction
+  class Scope
+  {
+  public:
+    /// Name must be a string literal or interned
+    inline Scope( const char* name );
+    inline ~Scope();
+  private:
+    const char* fName; /// < Scope name
+    double fStart; /// < Start time in seconds
+  };
+  /// Summary of a name's records
+  struct Stat
+  {
+    std::string fName; /// < Scope name
+    size_t fCount; /// < Number of records
+    double fTotal; /// < Summed duration in seconds
+    double fMedian; /// < Median duration in seconds
+    double fP95; /// < 95th percentile duration in seconds
+    double fMax; /// < Maximum duration in seconds
+  };
+  /// Summary of a counter's samples
+  struct Counter
+  {
+    std::string fName; /// < Counter name
+    double fLast; /// < Latest value
+    double fMean; /// < Mean value
+    double fMax; /// < Maximum value
+  };
+
+  /// Singleton class instance
+  static Profiler& GetInstance();
+
+  /// Return the time in seconds since the profiler started
+  double Now() const { return fClock.getElapsedTime().asSeconds(); }
+  /// Return a copy of the name that lives as long as the profiler, call once per name not per record
+  const char* Intern( const std::string& name );
+  /// Record a timed scope on the calling thread, name must be a string literal or interned
+  void Record( const char* name,
+               double start,
+               double end );
+  /// Record a sample of a counter on the calling thread, name must be a string literal or interned
+  void SetCounter( const char* name,
+                   double value );
+  /// Summarise the records that ended in the last window seconds, largest total first
+  void GetStats( double window,
+                 std::vector<Stat>& stats );
+  /// Summarise the counter samples in the last window seconds, by name
+  void GetCounters( double window,
+                    std::vector<Counter>& counters );
+  /// Write all the records as Chrome trace JSON, returns false on failure
+  bool WriteChromeTrace( const std::string& fileName );
+private:
+  struct Entry
+  {
+    const char* fName; /// < Scope or counter name
+    double fStart; /// < Start time in seconds
+    double fEnd; /// < End time in seconds, the sample time for a counter
+    double fValue; /// < Counter value
+    bool fCounter; /// < True if a counter sample rather than a scope
+  };
+  /// Ring buffer of a thread's records
+  struct Ring
+  {
+    Mutex fLock; /// < Guards the entries, only contended whilst reading
+    std::vector<Entry> fEntries; /// < The records, oldest overwritten first
+    size_t fNext; /// < Index the next record is written to
+    size_t fCount; /// < Number of valid records
+    int fThread; /// < Thread index, in order of first record
+  };
+  /// Add the entry to the calling thread's ring
+  void Add( const Entry& entry );
+  /// Copy the valid entries of all the rings, with the thread index
+  void Collect( std::vector< std::pair<int, Entry> >& entries );
+  /// Return the calling thread's ring, created on first use
+  Ring& GetRing();
+  /// Records the Scheduler task runs
+  static void TaskHook( const Scheduler::Task& task,
+                        double start,
+                        double end,
+                        int worker );
+
+  sf::Clock fClock; /// < Timing base
+  double fSchedulerOffset; /// < Profiler time less Scheduler time
+  pthread_key_t fRingKey; /// < Thread specific ring
+  Mutex fLock; /// < Guards the rings list and the names
+  std::vector<Ring*> fRings; /// < All the rings, never deleted as threads may still record
+  std::set<std::string> fNames; /// < Interned names
+
+  /// Prevent usage of methods below
+  Profiler();
+  Profiler( Profiler& );
+  void operator=( Profiler& );
+};
+
+inline Profiler&
+Profiler::GetInstance()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+inline
+Profiler::Scope::Scope( const char* name )
+  : fName( name ), fStart( Profiler::GetInstance().Now() )
+{
+
+}
+
+inline
+Profiler::Scope::~Scope()
+{
+  Profiler& profiler = Profiler::GetInstance();
+  profiler.Record( fName, fStart, profiler.Now() );
+}
+
+} //::Viewer
+
+#endif
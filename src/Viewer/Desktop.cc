@@ -14,6 +14,7 @@ using namespace std;
 #include <Viewer/GUIProperties.hh>
 #include <Viewer/DataSelector.hh>
 #include <Viewer/EventSummary.hh>
+#include <Viewer/Profiler.hh>
 using namespace Viewer;
 
 Desktop::Desktop( RectPtr desktopRect )
@@ -112,15 +113,21 @@ Desktop::SaveConfiguration( ConfigurationTable* configTable )
 void
 Desktop::ProcessData( bool force )
 {
+  Profiler::Scope scope( "Desktop::ProcessData" );
   // Process run first, suppliers the channel information
   if( force || DataSelector::GetInstance().RunChanged() )
     {
       fFrameManager->ProcessRun();
     }
-  if( force || fEventPanel->GetRenderState().HasChanged() || GUIProperties::GetInstance().HasChanged() || 
-      DataSelector::GetInstance().EventChanged() || fFrameManager->HasChanged() ) 
+  const RenderState& renderState = fEventPanel->GetRenderState();
+  if( force || renderState.HasStateChanged() || DataSelector::GetInstance().EventChanged() || fFrameManager->HasChanged() ) 
     {
-      fFrameManager->ProcessEvent( fEventPanel->GetRenderState() );
+      fFrameManager->ProcessEvent( renderState );
+    }
+  else if( renderState.HasChanged() || GUIProperties::GetInstance().HasChanged() )
+    {
+      // Only the scaling or colours have changed, frames can avoid reprocessing the event
+      fFrameManager->ProcessScaling( renderState );
     }
 }
 
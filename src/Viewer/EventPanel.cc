@@ -13,6 +13,7 @@ using namespace std;
 #include <Viewer/SlideSelector.hh>
 #include <Viewer/PersistLabel.hh>
 #include <Viewer/TextBox.hh>
+#include <Viewer/FramePacer.hh>
 using namespace Viewer;
 #include <Viewer/RIDS/Event.hh>
 
@@ -113,15 +114,22 @@ EventPanel::EventLoop()
         }
       fEvents.pop();
     }
-  // Manage the continuous event switching
+  // Manage the continuous event switching, new data invalidates the latest mode
   if( fLatest )
     eventSelector.Latest();
   else if( !fLatest && fEventPeriod == 0.0 )
-    eventSelector.Move( 1 );
-  else if( !fLatest && fEventPeriod > 0.0 && fClock.getElapsedTime().asSeconds() > fEventPeriod )
     {
       eventSelector.Move( 1 );
-      fClock.restart();
+      FramePacer::GetInstance().Invalidate();
+    }
+  else if( !fLatest && fEventPeriod > 0.0 )
+    {
+      if( fClock.getElapsedTime().asSeconds() > fEventPeriod )
+        {
+          eventSelector.Move( 1 );
+          fClock.restart();
+        }
+      FramePacer::GetInstance().InvalidateIn( fEventPeriod - fClock.getElapsedTime().asSeconds() );
     }
 }
 
@@ -0,0 +1,64 @@
+#include <SFML/System/Sleep.hpp>
+
+#include <algorithm>
+using namespace std;
+
+#include <Viewer/FramePacer.hh>
+using namespace Viewer;
+
+const double kPollPeriod = 0.01; // Maximum time between input and data polls, in seconds
+
+FramePacer::FramePacer()
+  : fDue( 0.0 ), fLastFrame( -1.0 ), fFramePeriod( 0.0 )
+{
+
+}
+
+void
+FramePacer::Invalidate()
+{
+  InvalidateIn( 0.0 );
+}
+
+void
+FramePacer::InvalidateIn( double seconds )
+{
+  Lock lock( fLock );
+  const double due = Now() + seconds;
+  if( fDue < 0.0 || due < fDue )
+    fDue = due;
+}
+
+void
+FramePacer::SetFrameRate( double frameRate )
+{
+  Lock lock( fLock );
+  fFramePeriod = 0.0;
+  if( frameRate > 0.0 )
+    fFramePeriod = 1.0 / frameRate;
+}
+
+bool
+FramePacer::StartFrame()
+{
+  Lock lock( fLock );
+  const double now = Now();
+  if( fDue < 0.0 || now < fDue || now < fLastFrame + fFramePeriod )
+    return false;
+  fDue = -1.0;
+  fLastFrame = now;
+  return true;
+}
+
+void
+FramePacer::Wait()
+{
+  double wait = kPollPeriod;
+  {
+    Lock lock( fLock );
+    if( fDue >= 0.0 )
+      wait = min( wait, max( fDue, fLastFrame + fFramePeriod ) - Now() );
+  }
+  if( wait > 0.0 )
+    sf::sleep( sf::seconds( static_cast<float>( wait ) ) );
+}
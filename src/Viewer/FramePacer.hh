@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////
+/// \class Viewer::FramePacer
+///
+/// \brief   Decides when the ViewerWindow should render a frame
+///
+/// \author  agent <agent@local>
+///
+/// REVISION HISTORY:\n
+///     18/10/26 : agent - First Revision, new file. \n
+///
+/// \detail  Anything that changes what is drawn calls Invalidate (now) or
+///          InvalidateIn (an animation or timer), the ViewerWindow only
+///          renders when a redraw is due and no faster than the frame
+///          rate cap. Input events and new data invalidate via the
+///          ViewerWindow. Invalidate is thread safe, so worker threads can
+///          request a redraw once their results are ready. This is a
+///          singleton class.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef __Viewer_FramePacer__
+#define __Viewer_FramePacer__
+
+#include <SFML/System/Clock.hpp>
+
+#include <Viewer/Mutex.hh>
+
+namespace Viewer
+{
+
+class FramePacer
+{
+public:
+  /// Singleton class instance
+  static FramePacer& GetInstance();
+
+  /// Request a redraw as soon as possible, thread safe
+  void Invalidate();
+  /// Request a redraw in seconds time, thread safe
+  void InvalidateIn( double seconds );
+  /// Set the frame rate cap, zero or less is uncapped
+  void SetFrameRate( double frameRate );
+
+  /// Return true and start a frame if a redraw is due. Called by the ViewerWindow ONLY
+  bool StartFrame();
+  /// Sleep until a redraw could be due, or the poll period. Called by the ViewerWindow ONLY
+  void Wait();
+private:
+  /// Return the time now in seconds
+  double Now() const { return fClock.getElapsedTime().asSeconds(); }
+
+  sf::Clock fClock; /// < Time since construction
+  Mutex fLock; /// < Guards the due time
+  double fDue; /// < Time the next redraw is due, negative if none
+  double fLastFrame; /// < Time the last frame started
+  double fFramePeriod; /// < Minimum time between frames
+
+  /// Prevent usage of methods below
+  FramePacer();
+  FramePacer( FramePacer& );
+  void operator=( FramePacer& );
+};
+
+inline FramePacer&
+FramePacer::GetInstance()
+{
+  static FramePacer framePacer;
+  return framePacer;
+}
+
+} //::Viewer
+
+#endif
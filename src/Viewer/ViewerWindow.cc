@@ -3,6 +3,7 @@
 #include <SFML/OpenGL.hpp>
 
 #include <string>
+#include <iostream>
 #include <stdio.h>
 using namespace std;
 
@@ -19,11 +20,15 @@ using namespace std;
 #include <Viewer/GUIProperties.hh>
 #include <Viewer/DataStore.hh>
 #include <Viewer/DataSelector.hh>
+#include <Viewer/VBO.hh>
+#include <Viewer/FramePacer.hh>
+#include <Viewer/Profiler.hh>
 using namespace Viewer;
 
 const int kConfigVersion = 1;
 
 ViewerWindow::ViewerWindow()
+  : fEventsAdded( 0 )
 {
   fMotherRect = &Rect::NewMother();
   sf::Rect<double> rect;
@@ -77,6 +82,7 @@ ViewerWindow::PreInitialise( const ConfigurationTable* configTable )
   fDesktopManager = new DesktopManager( RectPtr( fMotherRect ) );
   fDesktopManager->PreInitialise( configTable );
   fRWWrapper = new RWWrapper( *fWindowApp );
+  FramePacer::GetInstance().SetFrameRate( GUIProperties::GetInstance().GetConfiguration( "Rendering" )->GetD( "frameRate" ) );
 }
 
 void
@@ -89,15 +95,26 @@ void
 ViewerWindow::Run()
 {
   // PRECONDITION: SFML window is open.
+  FramePacer& framePacer = FramePacer::GetInstance();
+  DataSelector::GetInstance().Reset();
+  framePacer.Invalidate(); // Always draw the first frame
   while( true )
     {
       // Returns false on user controlled close
-      if( !EventLoop() ) 
+      if( !PollEvents() ) 
       {
         // This break is the only exit case
         break;
       }
+      if( !framePacer.StartFrame() )
+        {
+          framePacer.Wait(); // Nothing has changed, do not redraw
+          continue;
+        }
+      Profiler::Scope frameScope( "Frame" );
+      EventLoop();
       RenderLoop();
+      DataSelector::GetInstance().Reset(); // Changes have now been drawn
     }
 }
 void
@@ -121,16 +138,24 @@ ViewerWindow::Destruct()
 }
 
 bool
-ViewerWindow::EventLoop()
+ViewerWindow::PollEvents()
 {
   // DO NOT CLOSE fWindowApp HERE
   // WILL CLOSE WINDOW IN ViewerWindow::Destruct()
 
-  DataStore::GetInstance().Update();
-  DataSelector::GetInstance().Reset();
+  {
+    Profiler::Scope updateScope( "DataStore::Update" );
+    DataStore::GetInstance().Update();
+  }
+  if( DataStore::GetInstance().GetEventsAdded() != fEventsAdded )
+    {
+      fEventsAdded = DataStore::GetInstance().GetEventsAdded();
+      FramePacer::GetInstance().Invalidate();
+    }
   sf::Event event;
   while( fWindowApp->pollEvent( event ) )
     {
+      FramePacer::GetInstance().Invalidate(); // Any input may change the view, e.g. GUI hover
       switch( event.type )
         {
           // First ViewerWindow Specific Events
@@ -154,21 +179,38 @@ ViewerWindow::EventLoop()
             }
           if( GUI::fsKeyboardFocus == -1 && event.key.code == sf::Keyboard::S )
             fDesktopManager->ToggleScreenshot();
+          if( GUI::fsKeyboardFocus == -1 && event.key.code == sf::Keyboard::P )
+            {
+              if( Profiler::GetInstance().WriteChromeTrace( "snogoggles_trace.json" ) )
+                cout << "Profile saved to snogoggles_trace.json" << endl;
+              else
+                cout << "Failed to save the profile" << endl;
+            }
           //Drop through
         default:
           Event viewerEvent( event );
           fDesktopManager->NewEvent( viewerEvent );
         }
     }
+  return true;
+}
+
+void
+ViewerWindow::EventLoop()
+{
+  Profiler::Scope scope( "EventLoop" );
   // Now get Frames to deal with events
   fDesktopManager->EventLoop();
-  return true;
 }
 
 void
 ViewerWindow::RenderLoop()
 {
+  Profiler::Scope scope( "RenderLoop" );
   fRWWrapper->NewFrame();
+  VBO::NewFrame();
+  Profiler::GetInstance().SetCounter( "VBO draw calls", VBO::GetFrameDrawCalls() );
+  Profiler::GetInstance().SetCounter( "VBO upload bytes", VBO::GetFrameUploadBytes() );
   fWindowApp->setActive();
   SetGlobalGLStates();
 
@@ -177,8 +219,10 @@ ViewerWindow::RenderLoop()
   fWindowApp->pushGLStates(); // This call seems to be necessary.
   fDesktopManager->Render2d( *fRWWrapper );
   fDesktopManager->RenderGUI( *fRWWrapper );
+  fRWWrapper->Flush(); // Draw any batched text
   fWindowApp->popGLStates(); // Matches the save call above.
 
+  Profiler::Scope displayScope( "Display" );
   fWindowApp->display();
 }
 
@@ -12,7 +12,9 @@
 ///     18/02/12 : P.Jones - New overall structure refactor. \n
 ///
 /// \detail  As Brief, note this is only the drawable aspects of the 
-///          viewer.
+///          viewer. Input and new data are polled continuously, but the
+///          desktops only run their event loops and render when the
+///          FramePacer says a redraw is due.
 ///
 ////////////////////////////////////////////////////////////////////////
 
@@ -56,8 +58,10 @@ public:
 private:
   /// Initialise this window
   ViewerWindow();
-  /// Deal with any UI events
-  bool EventLoop();
+  /// Poll the UI events and new data, invalidates on either, returns false on close
+  bool PollEvents();
+  /// Let the desktops deal with the UI events
+  void EventLoop();
   /// Draw stuff to the screen
   void RenderLoop();
   /// Resets OpenGL's depth and stencil buffers.
@@ -70,6 +74,7 @@ private:
   Rect* fMotherRect; /// < The global mother rect
   sf::RenderWindow* fWindowApp; /// < The sfml window to draw on
   RWWrapper* fRWWrapper; /// < The render wrapper
+  size_t fEventsAdded; /// < DataStore events added at the last poll
 };
 
 inline ViewerWindow&